@@ -7,6 +7,7 @@
 #include <math.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <ctype.h>
 #include <stdarg.h>
 #include <dirent.h>
@@ -20,6 +21,9 @@
 #define STAT_ISDIR(mode) (((mode) & _S_IFDIR) != 0)
 #else
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 #define TAPE_GETCWD getcwd
 #define STAT_STRUCT struct stat
 #define STAT_FUNC stat
@@ -340,6 +344,10 @@ static SpectrumContentionProfile spectrum_contention_profile = CONTENTION_PROFIL
 static PeripheralContentionProfile peripheral_contention_profile = PERIPHERAL_CONTENTION_NONE;
 static uint8_t rom_pages[4][0x4000];
 static uint8_t ram_pages[8][0x4000];
+// Per-bank dirty flags for the rewind ring: set by the RAM write shadow and
+// by anything that stores into ram_pages behind its back, cleared on capture.
+static uint8_t rewind_bank_dirty[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+static int rewind_enabled = 0;
 static uint8_t current_rom_page = 0;
 static uint8_t current_screen_bank = 5;
 static uint8_t current_paged_bank = 0;
@@ -402,6 +410,11 @@ SDL_Renderer* renderer = NULL;
 SDL_Texture* texture = NULL;
 uint32_t pixels[ TOTAL_WIDTH * TOTAL_HEIGHT ];
 static int window_fullscreen = 0;
+static int headless_mode = 0;
+static int turbo_mode = 0;
+static uint64_t exit_after_frames = 0;
+static uint64_t exit_after_tstates = 0;
+static uint64_t emulated_frame_count = 0;
 
 // --- Audio Globals ---
 volatile int beeper_state = 0; // 0 = low, 1 = high
@@ -430,6 +443,8 @@ static const double AY_CLOCK_HZ = 1750000.0;
 static double ay_cycles_per_sample = 0.0;
 static double ay_global_gain = 6000.0;
 static double ay_channel_pan[3] = {-0.75, 0.0, 0.75};
+static double ay_pan_gain_left[3] = {0.0, 0.0, 0.0};
+static double ay_pan_gain_right[3] = {0.0, 0.0, 0.0};
 static const double ay_volume_table[16] = {
     0.0000, 0.0049, 0.0098, 0.0205,
     0.0390, 0.0600, 0.0901, 0.1353,
@@ -472,6 +487,29 @@ static const int TAPE_DATA_PILOT_COUNT = 3223;
 static const uint64_t TAPE_SILENCE_THRESHOLD_TSTATES = 350000ULL; // 0.1 second
 static const uint64_t TAPE_RECORDER_AUTOSTOP_TSTATES = 7000000ULL; // ~2 seconds
 
+// Consumed pulses are trimmed from a streamed waveform window once it grows
+// past this many entries.
+#define TAPE_WAVEFORM_WINDOW_PULSES 4096u
+
+// Bytes of WAV sample data decoded per refill of the streamed pulse window.
+#define TAPE_WAV_STREAM_CHUNK_BYTES 65536u
+
+// Tape images, their waveforms and the recorder capture buffers are carved
+// from slab arenas so ejecting a tape releases everything in O(1) instead of
+// walking and freeing block by block. Long sessions that cycle through many
+// tapes used to fragment the heap with the old per-allocation frees.
+#define TAPE_ARENA_SLAB_BYTES (64u * 1024u)
+
+typedef struct TapeArenaSlab {
+    struct TapeArenaSlab* next;
+    size_t capacity;
+    size_t used;
+} TapeArenaSlab;
+
+typedef struct {
+    TapeArenaSlab* head;
+} TapeArena;
+
 typedef enum {
     TAPE_BLOCK_TYPE_STANDARD,
     TAPE_BLOCK_TYPE_TURBO,
@@ -503,12 +541,18 @@ typedef struct {
     uint8_t* direct_samples;
     uint32_t direct_sample_count;
     int direct_initial_level;
+    uint8_t data_is_reference;           // data points into the image backing
+    uint8_t direct_samples_is_reference; // direct_samples points into the backing
 } TapeBlock;
 
 typedef struct {
     TapeBlock* blocks;
     size_t count;
     size_t capacity;
+    uint8_t* backing;     // whole-file buffer that reference blocks point into
+    size_t backing_size;
+    int backing_is_mapped; // release with munmap instead of free
+    TapeArena arena;      // backs blocks[] and all copied payloads
 } TapeImage;
 
 typedef struct {
@@ -521,6 +565,15 @@ typedef struct {
     size_t capacity;
     int initial_level;
     uint32_t sample_rate;
+    // Streaming expansion (TAP/TZX image playback): pulses[] is a sliding
+    // window whose first entry is absolute pulse index window_base; blocks
+    // are expanded on demand as playback consumes the window.
+    int streaming;
+    size_t window_base;
+    size_t stream_next_block;
+    uint64_t stream_pending_silence;
+    int stream_done;
+    TapeArena arena; // backs pulses[]
 } TapeWaveform;
 
 typedef enum {
@@ -548,11 +601,37 @@ typedef enum {
     TAPE_PHASE_DONE
 } TapePhase;
 
+// Windowed WAV decoding: the data chunk stays on disk and fixed-size runs of
+// samples are decoded into the waveform window as playback consumes it.
+typedef struct {
+    FILE* file;
+    long data_offset;
+    uint32_t data_size;
+    int bytes_per_sample;
+    uint64_t total_samples;
+    uint64_t next_sample;
+    int previous_level;
+    uint64_t run_length;
+    double tstates_per_sample;
+    int done;
+} TapeWavStream;
+
+// Per-block seek index, built once at load time from the same expansion the
+// waveform generator uses: where each block's pulses begin in the waveform
+// and how many t-states of tape precede it.
+typedef struct {
+    uint64_t start_pulse;
+    uint64_t start_tstates;
+} TapeBlockIndexEntry;
+
 typedef struct {
     TapeImage image;
     TapeWaveform waveform;
+    TapeWavStream wav_stream;
     TapeFormat format;
     int use_waveform_playback;
+    TapeBlockIndexEntry* block_index; // one entry per image block, or NULL
+    size_t block_index_count;
     size_t current_block;
     TapePhase phase;
     int pilot_pulses_remaining;
@@ -602,6 +681,7 @@ typedef struct {
     TapePulse* pulses;
     size_t pulse_count;
     size_t pulse_capacity;
+    TapeArena pulse_arena;
     uint64_t last_transition_tstate;
     int last_level;
     int block_active;
@@ -612,6 +692,7 @@ typedef struct {
     int16_t* audio_samples;
     size_t audio_sample_count;
     size_t audio_sample_capacity;
+    TapeArena audio_arena;
     int16_t* wav_prefix_samples;
     size_t wav_prefix_sample_count;
     TapeOutputFormat output_format;
@@ -656,6 +737,7 @@ typedef enum {
 
 static TapeDeckStatus tape_deck_status = TAPE_DECK_STATUS_IDLE;
 static int tape_debug_logging = 0;
+static int tape_preload_waveform = 0;
 static int paging_debug_logging = 0;
 static int paging_log_registers = 0;
 static int ram_hash_logging = 0;
@@ -911,6 +993,9 @@ static const char* tape_input_path = NULL;
 static char tape_input_path_storage[PATH_MAX];
 static SnapshotFormat snapshot_input_format = SNAPSHOT_FORMAT_NONE;
 static const char* snapshot_input_path = NULL;
+static char snapshot_save_path_storage[PATH_MAX];
+static const char* snapshot_save_path = NULL;
+static uint64_t snapshot_save_at_frame = 0;
 
 static int string_ends_with_case_insensitive(const char* str, const char* suffix);
 static TapeFormat tape_format_from_extension(const char* path);
@@ -918,9 +1003,11 @@ static SnapshotFormat snapshot_format_from_extension(const char* path);
 static int snapshot_load_sna(const char* path, Z80* cpu);
 static int snapshot_load_z80(const char* path, Z80* cpu);
 static int snapshot_load(const char* path, SnapshotFormat format, Z80* cpu);
+static int snapshot_save_z80(const char* path, const Z80* cpu);
+static void snapshot_save_request(const Z80* cpu);
 static int tape_load_image(const char* path, TapeFormat format, TapeImage* image);
 static void tape_free_image(TapeImage* image);
-static int tape_image_add_block(TapeImage* image, const uint8_t* data, uint32_t length, uint32_t pause_ms);
+static int tape_image_add_block(TapeImage* image, const uint8_t* data, uint32_t length, uint32_t pause_ms, int copy_data);
 static void tape_reset_playback(TapePlaybackState* state);
 static void tape_start_playback(TapePlaybackState* state, uint64_t start_time);
 static void tape_pause_playback(TapePlaybackState* state, uint64_t current_t_state);
@@ -933,6 +1020,9 @@ static void tape_waveform_reset(TapeWaveform* waveform);
 static int tape_waveform_add_pulse(TapeWaveform* waveform, uint64_t duration);
 static int tape_waveform_add_with_pending(TapeWaveform* waveform, uint64_t duration, uint64_t* pending_silence);
 static int tape_generate_waveform_from_image(const TapeImage* image, TapeWaveform* waveform);
+static void tape_free_block_index(TapePlaybackState* state);
+static int tape_build_block_index(TapePlaybackState* state);
+static int tape_jump_to_block(TapePlaybackState* state, size_t block_index, uint64_t current_t_state);
 static int tape_load_wav(const char* path, TapePlaybackState* state);
 static int tape_create_blank_wav(const char* path, uint32_t sample_rate);
 static void tape_manager_browser_normalize_separators(char* path);
@@ -945,6 +1035,8 @@ static void tape_manager_browser_clamp_selection(void);
 static void tape_manager_browser_move_selection(int delta);
 static void tape_manager_browser_page_selection(int delta);
 static int tape_manager_refresh_browser(const char* directory);
+static void tape_manager_browser_poll(void);
+static void tape_browser_scan_stop(void);
 static void tape_manager_begin_browser(void);
 static void tape_manager_browser_activate_selection(void);
 static void tape_manager_browser_go_parent(void);
@@ -962,8 +1054,16 @@ static void tape_recorder_reset_wav_prefix(void);
 static size_t tape_recorder_samples_from_tstates(uint64_t duration);
 static uint64_t tape_recorder_tstates_from_samples(uint64_t sample_count);
 static int tape_recorder_append_audio_samples(int level, size_t sample_count);
-static void tape_recorder_append_block_audio(uint64_t idle_cycles);
+static void tape_recorder_append_block_audio(const TapePulse* pulses,
+                                             size_t pulse_count,
+                                             int block_start_level,
+                                             int last_level,
+                                             uint64_t idle_cycles);
 static int tape_recorder_write_wav(void);
+static int tape_decode_pulses_to_block(const TapePulse* pulses, size_t count, uint32_t pause_ms, TapeBlock* out_block);
+static int tape_encoder_start(void);
+static void tape_encoder_drain(void);
+static void tape_encoder_stop(void);
 static int tape_recorder_prepare_append_wav(uint32_t* data_chunk_offset,
                                             uint32_t* existing_bytes,
                                             uint32_t* sample_rate_out);
@@ -999,17 +1099,38 @@ static int speaker_calculate_output_level(void);
 static void speaker_update_output(uint64_t t_state, int emit_event);
 static void ay_reset_state(void);
 static void ay_set_sample_rate(int sample_rate);
-static void ay_mix_sample(double elapsed_cycles, double* left_out, double* right_out);
+static void ay_render_block(double cycles_per_sample, int num_frames, double* left_out, double* right_out);
 static void ay_write_register(uint8_t reg, uint8_t value);
 static int ay_parse_pan_spec(const char* spec);
 static void toggle_fullscreen(void);
 static void ula_queue_port_value(uint8_t value);
 static void ula_process_port_events(uint64_t current_t_state);
+static void scheduler_invalidate(void);
+static void scheduler_service(uint64_t current_t_state);
 
 static FILE* audio_dump_file = NULL;
 static uint32_t audio_dump_data_bytes = 0;
 static uint16_t audio_dump_channels = 1;
 
+// Audio dump ring: single producer (audio callback) / single consumer
+// (writer thread). The callback used to fwrite straight to the dump file,
+// which put disk latency on the real-time audio thread; now it only memcpys
+// into a preallocated ring and the writer thread coalesces the samples into
+// large chunked writes. head and tail follow the beeper event ring's
+// acquire/release discipline so the callback never takes a lock. If the ring
+// fills because the disk cannot keep up, the callback drops samples and
+// counts them rather than ever blocking.
+#define AUDIO_DUMP_RING_SAMPLES (1u << 20)       // 2 MiB, ~10s of stereo 48kHz
+#define AUDIO_DUMP_WRITE_CHUNK_SAMPLES (1u << 15) // 64 KiB per fwrite
+
+static Sint16* audio_dump_ring = NULL;
+static _Atomic size_t audio_dump_ring_head = 0;
+static _Atomic size_t audio_dump_ring_tail = 0;
+static _Atomic int audio_dump_active = 0;
+static _Atomic int audio_dump_writer_stop = 0;
+static SDL_Thread* audio_dump_writer_thread = NULL;
+static uint64_t audio_dump_dropped_samples = 0; // touched by the callback only
+
 #define BEEPER_EVENT_CAPACITY 8192
 
 typedef struct {
@@ -1017,13 +1138,18 @@ typedef struct {
     int8_t level;
 } BeeperEvent;
 
+// Single-producer (CPU loop) / single-consumer (audio callback) event ring.
+// head and tail are atomic so the common-case push and the latency probes
+// never take the audio lock; the lock is only held for the rare operations
+// that mutate the consumer's side from the producer (catch-up, resync, and
+// evicting the oldest event when the ring is full).
 static BeeperEvent beeper_events[BEEPER_EVENT_CAPACITY];
-static size_t beeper_event_head = 0;
-static size_t beeper_event_tail = 0;
-static uint64_t beeper_last_event_t_state = 0;
+static _Atomic size_t beeper_event_head = 0;
+static _Atomic size_t beeper_event_tail = 0;
+static _Atomic uint64_t beeper_last_event_t_state = 0;
 static double beeper_cycles_per_sample = 0.0;
-static double beeper_playback_position = 0.0;
-static double beeper_writer_cursor = 0.0;
+static _Atomic double beeper_playback_position = 0.0;
+static _Atomic double beeper_writer_cursor = 0.0;
 static double beeper_hp_last_input = 0.0;
 static double beeper_hp_last_output = 0.0;
 static int beeper_playback_level = 0;
@@ -1045,6 +1171,25 @@ static void beeper_force_resync(uint64_t sync_t_state);
 // --- Timing Globals ---
 uint64_t total_t_states = 0; // A global clock for the entire CPU
 
+// --- Performance counters ---
+// Always-on stats layer for field diagnostics: plain (non-atomic) increments
+// so the hot paths stay cheap enough to leave enabled in production builds.
+// The audio callback updates its counters from the audio thread, so those
+// values are approximate — acceptable for a stats readout.
+typedef struct {
+    uint64_t instructions_retired;
+    uint64_t contended_accesses;
+    uint64_t uncontended_accesses;
+    uint64_t beeper_events_queued;
+    uint64_t beeper_events_dropped;
+    uint64_t frames_rendered;
+    uint64_t frames_skipped;
+    uint64_t audio_underruns;
+} PerfCounters;
+
+static PerfCounters perf_counters;
+static int perf_overlay_visible = 0;
+
 // --- ZX Spectrum Colours ---
 const uint32_t spectrum_colors[8] = {0x000000FF,0x0000CDFF,0xCD0000FF,0xCD00CDFF,0x00CD00FF,0x00CDCDFF,0xCDCD00FF,0xCFCFCFFF};
 const uint32_t spectrum_bright_colors[8] = {0x000000FF,0x0000FFFF,0xFF0000FF,0xFF00FFFF,0x00FF00FF,0x00FFFFFF,0xFFFF00FF,0xFFFFFFFF};
@@ -1119,6 +1264,177 @@ static void auto_key_sequence_start(AutoKeySequence* sequence,
                             steps[0].mask2);
 }
 
+// --- Input recording and deterministic replay ---
+// Normal runs derive CPU cycles from the wall clock, so two runs of the same
+// tape never execute identical t-state sequences and field failures are hard
+// to reproduce. --record-input logs every user-driven keyboard matrix change
+// with the t-state it took effect at; --replay-input feeds those changes back
+// through the scheduler at the recorded offsets while the main loop steps
+// exact frame quanta, so the replayed session is bit-exact regardless of host
+// timing (and runs flat out when combined with --turbo). Synthetic matrix
+/// changes (the tape autoload driver) are not recorded: they are themselves
+// driven by t-states and reproduce on their own.
+#define INPUT_EVENT_FILE_MAGIC "Z80I"
+#define INPUT_EVENT_FILE_VERSION 1u
+
+typedef struct {
+    uint64_t t_state;
+    uint8_t row;
+    uint8_t value; // keyboard_matrix[row] after the change
+} InputEvent;
+
+static FILE* input_record_file = NULL;
+static uint64_t input_record_event_count = 0;
+
+static InputEvent* input_replay_events = NULL;
+static size_t input_replay_count = 0;
+static size_t input_replay_next = 0;
+static int input_replay_active = 0; // events still pending
+static int input_replay_mode = 0;   // fixed-step replay session (whole run)
+
+static int input_record_begin(const char* path) {
+    input_record_file = fopen(path, "wb");
+    if (!input_record_file) {
+        fprintf(stderr, "Failed to open input recording '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+    uint8_t header[8];
+    memcpy(header, INPUT_EVENT_FILE_MAGIC, 4);
+    header[4] = (uint8_t)INPUT_EVENT_FILE_VERSION;
+    header[5] = 0;
+    header[6] = 0;
+    header[7] = 0;
+    if (fwrite(header, sizeof(header), 1, input_record_file) != 1) {
+        fprintf(stderr, "Failed to write input recording header to '%s'\n", path);
+        fclose(input_record_file);
+        input_record_file = NULL;
+        return 0;
+    }
+    input_record_event_count = 0;
+    printf("Recording input events to %s\n", path);
+    return 1;
+}
+
+static void input_record_key(uint64_t t_state, int row, uint8_t value) {
+    if (!input_record_file || row < 0 || row >= 8) {
+        return;
+    }
+    uint8_t record[10];
+    for (int i = 0; i < 8; ++i) {
+        record[i] = (uint8_t)(t_state >> (8 * i));
+    }
+    record[8] = (uint8_t)row;
+    record[9] = value;
+    if (fwrite(record, sizeof(record), 1, input_record_file) != 1) {
+        fprintf(stderr, "Failed to append input event; closing recording\n");
+        fclose(input_record_file);
+        input_record_file = NULL;
+        return;
+    }
+    // Key events are rare; flush each one so a crashed session still leaves
+    // a usable recording behind.
+    fflush(input_record_file);
+    input_record_event_count++;
+}
+
+static void input_record_finish(void) {
+    if (!input_record_file) {
+        return;
+    }
+    fclose(input_record_file);
+    input_record_file = NULL;
+    printf("Recorded %" PRIu64 " input events\n", input_record_event_count);
+}
+
+static int input_replay_load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open input replay '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    uint8_t header[8];
+    if (fread(header, sizeof(header), 1, file) != 1 ||
+        memcmp(header, INPUT_EVENT_FILE_MAGIC, 4) != 0 ||
+        header[4] != (uint8_t)INPUT_EVENT_FILE_VERSION) {
+        fprintf(stderr, "'%s' is not a version %u input recording\n", path, INPUT_EVENT_FILE_VERSION);
+        fclose(file);
+        return 0;
+    }
+
+    size_t capacity = 0;
+    size_t count = 0;
+    InputEvent* events = NULL;
+    uint8_t record[10];
+    while (fread(record, sizeof(record), 1, file) == 1) {
+        if (count == capacity) {
+            size_t new_capacity = capacity ? capacity * 2u : 256u;
+            InputEvent* grown = (InputEvent*)realloc(events, new_capacity * sizeof(InputEvent));
+            if (!grown) {
+                fprintf(stderr, "Out of memory loading input replay '%s'\n", path);
+                free(events);
+                fclose(file);
+                return 0;
+            }
+            events = grown;
+            capacity = new_capacity;
+        }
+        InputEvent* event = &events[count];
+        event->t_state = 0;
+        for (int i = 0; i < 8; ++i) {
+            event->t_state |= (uint64_t)record[i] << (8 * i);
+        }
+        event->row = (uint8_t)(record[8] & 0x07u);
+        event->value = record[9];
+        // Guard against hand-edited files: replay consumes events in order.
+        if (count > 0 && event->t_state < events[count - 1].t_state) {
+            event->t_state = events[count - 1].t_state;
+        }
+        count++;
+    }
+    fclose(file);
+
+    input_replay_events = events;
+    input_replay_count = count;
+    input_replay_next = 0;
+    input_replay_active = count > 0;
+    input_replay_mode = 1;
+    printf("Replaying %zu input events from %s\n", count, path);
+    return 1;
+}
+
+static uint64_t input_replay_next_deadline(void) {
+    if (!input_replay_active || input_replay_next >= input_replay_count) {
+        return UINT64_MAX;
+    }
+    return input_replay_events[input_replay_next].t_state;
+}
+
+static void input_replay_apply(uint64_t current_t_state) {
+    if (!input_replay_active) {
+        return;
+    }
+    while (input_replay_next < input_replay_count &&
+           input_replay_events[input_replay_next].t_state <= current_t_state) {
+        const InputEvent* event = &input_replay_events[input_replay_next];
+        keyboard_matrix[event->row] = event->value;
+        input_replay_next++;
+    }
+    if (input_replay_next >= input_replay_count && input_replay_count > 0) {
+        printf("Input replay finished (%zu events)\n", input_replay_count);
+        input_replay_active = 0;
+    }
+}
+
+static void input_replay_shutdown(void) {
+    free(input_replay_events);
+    input_replay_events = NULL;
+    input_replay_count = 0;
+    input_replay_next = 0;
+    input_replay_active = 0;
+    input_replay_mode = 0;
+}
+
 // --- ROM Handling ---
 static const char *default_rom_filename = "48.rom";
 
@@ -1175,7 +1491,7 @@ static int spectrum_rom_contains_ascii_case_insensitive(const uint8_t *rom,
     return 0;
 }
 
-static int spectrum_rom_bank_seems_48k_basic(const uint8_t *rom) {
+static int spectrum_rom_scan_48k_basic(const uint8_t *rom) {
     if (!rom) {
         return 0;
     }
@@ -1185,7 +1501,7 @@ static int spectrum_rom_bank_seems_48k_basic(const uint8_t *rom) {
     return has_1982 && has_sinclair_research;
 }
 
-static int spectrum_rom_bank_seems_128k_menu(const uint8_t *rom) {
+static int spectrum_rom_scan_128k_menu(const uint8_t *rom) {
     if (!rom) {
         return 0;
     }
@@ -1208,6 +1524,146 @@ static int spectrum_rom_bank_seems_128k_menu(const uint8_t *rom) {
     return has_128_text;
 }
 
+// --- ROM signature cache ---
+// The menu/BASIC detection above runs case-insensitive substring scans over
+// every 16 KB bank on each startup. The verdicts depend only on the bank
+// contents, so they are cached content-addressed in a small text file under
+// the user ROM directory, keyed by spectrum_hash_buffer() of the bank: warm
+// startups validate the hash and skip the byte-wise scans entirely.
+#define ROM_SIGNATURE_CACHE_CAPACITY 64u
+#define ROM_SIGNATURE_CACHE_FILENAME "rom-cache.txt"
+
+typedef struct {
+    uint32_t hash;
+    uint8_t seems_basic;
+    uint8_t seems_menu;
+} RomSignatureCacheEntry;
+
+static RomSignatureCacheEntry rom_signature_cache[ROM_SIGNATURE_CACHE_CAPACITY];
+static size_t rom_signature_cache_count = 0;
+static int rom_signature_cache_loaded = 0;
+static int rom_signature_cache_dirty = 0;
+
+static int rom_signature_cache_file_path(char *out, size_t out_size) {
+    if (spectrum_user_roms_dir[0] == '\0') {
+        return 0;
+    }
+    return spectrum_join_path(spectrum_user_roms_dir, ROM_SIGNATURE_CACHE_FILENAME, out, out_size);
+}
+
+static RomSignatureCacheEntry *rom_signature_cache_find(uint32_t hash) {
+    for (size_t i = 0; i < rom_signature_cache_count; ++i) {
+        if (rom_signature_cache[i].hash == hash) {
+            return &rom_signature_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void rom_signature_cache_load(void) {
+    if (rom_signature_cache_loaded) {
+        return;
+    }
+    rom_signature_cache_loaded = 1;
+
+    char path[PATH_MAX];
+    if (!rom_signature_cache_file_path(path, sizeof(path))) {
+        return;
+    }
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return;
+    }
+
+    char line[64];
+    while (rom_signature_cache_count < ROM_SIGNATURE_CACHE_CAPACITY &&
+           fgets(line, sizeof(line), file)) {
+        unsigned int hash = 0;
+        int seems_basic = 0;
+        int seems_menu = 0;
+        if (line[0] == '#' || sscanf(line, "%8x %d %d", &hash, &seems_basic, &seems_menu) != 3) {
+            continue;
+        }
+        if (rom_signature_cache_find((uint32_t)hash)) {
+            continue;
+        }
+        RomSignatureCacheEntry *entry = &rom_signature_cache[rom_signature_cache_count++];
+        entry->hash = (uint32_t)hash;
+        entry->seems_basic = seems_basic ? 1u : 0u;
+        entry->seems_menu = seems_menu ? 1u : 0u;
+    }
+    fclose(file);
+}
+
+static void rom_signature_cache_save(void) {
+    if (!rom_signature_cache_dirty) {
+        return;
+    }
+
+    char path[PATH_MAX];
+    if (!rom_signature_cache_file_path(path, sizeof(path))) {
+        return;
+    }
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return;
+    }
+
+    fprintf(file, "# ROM bank signature cache: <bank hash> <48k basic> <128k menu>\n");
+    for (size_t i = 0; i < rom_signature_cache_count; ++i) {
+        fprintf(file,
+                "%08x %d %d\n",
+                (unsigned int)rom_signature_cache[i].hash,
+                (int)rom_signature_cache[i].seems_basic,
+                (int)rom_signature_cache[i].seems_menu);
+    }
+    fclose(file);
+    rom_signature_cache_dirty = 0;
+}
+
+static void spectrum_rom_classify_bank(const uint8_t *rom, int *seems_basic, int *seems_menu) {
+    if (!rom) {
+        *seems_basic = 0;
+        *seems_menu = 0;
+        return;
+    }
+
+    rom_signature_cache_load();
+    uint32_t hash = spectrum_hash_buffer(rom, 0x4000u);
+    const RomSignatureCacheEntry *entry = rom_signature_cache_find(hash);
+    if (entry) {
+        *seems_basic = entry->seems_basic;
+        *seems_menu = entry->seems_menu;
+        return;
+    }
+
+    int basic = spectrum_rom_scan_48k_basic(rom);
+    int menu = spectrum_rom_scan_128k_menu(rom);
+    if (rom_signature_cache_count < ROM_SIGNATURE_CACHE_CAPACITY) {
+        RomSignatureCacheEntry *slot = &rom_signature_cache[rom_signature_cache_count++];
+        slot->hash = hash;
+        slot->seems_basic = basic ? 1u : 0u;
+        slot->seems_menu = menu ? 1u : 0u;
+        rom_signature_cache_dirty = 1;
+    }
+    *seems_basic = basic;
+    *seems_menu = menu;
+}
+
+static int spectrum_rom_bank_seems_48k_basic(const uint8_t *rom) {
+    int seems_basic = 0;
+    int seems_menu = 0;
+    spectrum_rom_classify_bank(rom, &seems_basic, &seems_menu);
+    return seems_basic;
+}
+
+static int spectrum_rom_bank_seems_128k_menu(const uint8_t *rom) {
+    int seems_basic = 0;
+    int seems_menu = 0;
+    spectrum_rom_classify_bank(rom, &seems_basic, &seems_menu);
+    return seems_menu;
+}
+
 static void spectrum_swap_rom_banks(size_t a,
                                     size_t b,
                                     uint8_t bank_loaded[4],
@@ -1762,6 +2218,8 @@ static int spectrum_populate_rom_pages(const char *rom_primary_path,
         printf("    signature: %s\n", classification);
     }
 
+    rom_signature_cache_save();
+
     return 1;
 }
 
@@ -1813,12 +2271,18 @@ int cpu_nmi(Z80* cpu);
 int cpu_ddfd_cb_step(Z80* cpu, uint16_t* index_reg, int is_ix);
 void audio_callback(void* userdata, Uint8* stream, int len);
 static void border_record_event(uint64_t event_t_state, uint8_t color_idx);
-static void border_draw_span(uint64_t span_start, uint64_t span_end, uint8_t color_idx);
+static int border_blit_scanlines(uint8_t start_color, int full_redraw);
 static void spectrum_map_page(int segment, SpectrumMemoryPageType type, uint8_t index);
 static void spectrum_refresh_visible_ram(void);
 static void spectrum_apply_memory_configuration(void);
 static void spectrum_update_contention_flags(void);
 static inline int ula_contention_penalty(uint64_t t_state);
+static uint8_t spectrum_read_fast(uint16_t addr);
+static uint8_t spectrum_read_contended(uint16_t addr);
+static void spectrum_write_discard_fast(uint16_t addr, uint8_t val);
+static void spectrum_write_discard_contended(uint16_t addr, uint8_t val);
+static void spectrum_write_ram_fast(uint16_t addr, uint8_t val);
+static void spectrum_write_ram_contended(uint16_t addr, uint8_t val);
 static void beeper_reset_audio_state(uint64_t current_t_state, int current_level);
 static void beeper_set_latency_limit(double sample_limit);
 static void beeper_push_event(uint64_t t_state, int level);
@@ -1827,6 +2291,7 @@ static double beeper_current_latency_samples(void);
 static double beeper_latency_threshold(void);
 static Uint32 beeper_recommended_throttle_delay(double latency_samples);
 static int audio_dump_start(const char* path, uint32_t sample_rate, uint16_t channels);
+static int audio_dump_writer_main(void* data);
 static void audio_dump_write_samples(const Sint16* samples, size_t count);
 static void audio_dump_finish(void);
 static void audio_dump_abort(void);
@@ -1895,6 +2360,155 @@ static inline int spectrum_is_ram_bank_contended(uint8_t bank) {
     return (mask & (uint8_t)(1u << bank)) != 0u;
 }
 
+// Dirty tracking for the display file: one flag per 8x8 attribute cell so the
+// render path only re-decodes cells whose pixel or attribute bytes changed.
+// Bulk memory updates (bank remaps, snapshot loads) fall back to a full redraw.
+#define SCREEN_CELL_ROWS (SCREEN_HEIGHT / 8)
+#define SCREEN_CELL_COLS (SCREEN_WIDTH / 8)
+#define SCREEN_PIXEL_BYTES 0x1800u
+#define SCREEN_DISPLAY_BYTES 0x1B00u
+
+static uint8_t screen_dirty_cells[SCREEN_CELL_ROWS][SCREEN_CELL_COLS];
+static int screen_force_full_redraw = 1;
+
+// --- Pixel expansion masks ---
+// One 8-wide mask row per display byte, leftmost pixel (bit 7) first. The
+// per-bit shift-and-branch decode mispredicts badly on interleaved ink/paper
+// patterns; with the masks each character row becomes eight branchless
+// select stores (pap ^ ((ink ^ pap) & mask)) that the compiler turns into a
+// pair of 16-byte vector stores on SSE2/NEON targets.
+static uint32_t screen_pixel_expand_masks[256][8];
+
+static void screen_init_pixel_expand_masks(void) {
+    for (unsigned value = 0; value < 256u; ++value) {
+        for (unsigned px = 0; px < 8u; ++px) {
+            screen_pixel_expand_masks[value][px] =
+                (value & (0x80u >> px)) ? 0xFFFFFFFFu : 0x00000000u;
+        }
+    }
+}
+
+// --- Render thread ---
+// render_screen() normally ends with SDL_RenderPresent() on a vsync'd
+// renderer, so the emulation thread can stall up to a full display refresh —
+// the main source of beeper latency spikes. With --render-thread the
+// emulation thread instead snapshots the finished frame (overlays included)
+// into a triple buffer and a dedicated thread owns the texture upload and
+// present, absorbing the vsync wait. The snapshot memcpy costs a fraction of
+// a millisecond and never blocks. SDL does not promise that renderer calls
+// work off the main thread on every backend, so this stays opt-in.
+static int render_thread_requested = 0;
+static int render_thread_active = 0;
+static SDL_Thread* render_thread_handle = NULL;
+static SDL_mutex* render_thread_lock = NULL;
+static SDL_cond* render_thread_wake = NULL;
+static int render_thread_quit = 0;
+static uint32_t render_thread_buffers[3][TOTAL_WIDTH * TOTAL_HEIGHT];
+static int render_thread_produce_index = 0;
+static int render_thread_ready_index = 1;
+static int render_thread_consume_index = 2;
+static int render_thread_frame_fresh = 0;
+
+// Buffer hand-off, factored out so the protocol is unit-testable: the
+// producer swaps its filled buffer into the ready slot, the consumer swaps
+// the ready slot with its display buffer, and the two sides never hold the
+// same index. An unconsumed ready frame is simply overwritten (dropped).
+static int render_frame_exchange_publish(void) {
+    int filled = render_thread_produce_index;
+    render_thread_produce_index = render_thread_ready_index;
+    render_thread_ready_index = filled;
+    render_thread_frame_fresh = 1;
+    return render_thread_produce_index;
+}
+
+static int render_frame_exchange_acquire(void) {
+    if (!render_thread_frame_fresh) {
+        return -1;
+    }
+    int ready = render_thread_ready_index;
+    render_thread_ready_index = render_thread_consume_index;
+    render_thread_consume_index = ready;
+    render_thread_frame_fresh = 0;
+    return ready;
+}
+
+static void render_thread_publish_frame(void) {
+    memcpy(render_thread_buffers[render_thread_produce_index], pixels, sizeof(pixels));
+    SDL_LockMutex(render_thread_lock);
+    (void)render_frame_exchange_publish();
+    SDL_CondSignal(render_thread_wake);
+    SDL_UnlockMutex(render_thread_lock);
+}
+
+static int render_thread_main(void* data) {
+    (void)data;
+    for (;;) {
+        SDL_LockMutex(render_thread_lock);
+        while (!render_thread_frame_fresh && !render_thread_quit) {
+            SDL_CondWait(render_thread_wake, render_thread_lock);
+        }
+        if (render_thread_quit) {
+            SDL_UnlockMutex(render_thread_lock);
+            break;
+        }
+        int frame = render_frame_exchange_acquire();
+        SDL_UnlockMutex(render_thread_lock);
+        if (frame < 0) {
+            continue;
+        }
+        SDL_UpdateTexture(texture, NULL, render_thread_buffers[frame], TOTAL_WIDTH * sizeof(uint32_t));
+        SDL_RenderClear(renderer);
+        SDL_RenderCopy(renderer, texture, NULL, NULL);
+        SDL_RenderPresent(renderer); // vsync wait lands here, off the emulation thread
+    }
+    return 0;
+}
+
+static void render_thread_start(void) {
+    if (render_thread_active || headless_mode || !render_thread_requested) {
+        return;
+    }
+    render_thread_lock = SDL_CreateMutex();
+    render_thread_wake = SDL_CreateCond();
+    if (!render_thread_lock || !render_thread_wake) {
+        fprintf(stderr, "Warning: render thread unavailable (%s); presenting inline\n", SDL_GetError());
+        return;
+    }
+    render_thread_quit = 0;
+    render_thread_handle = SDL_CreateThread(render_thread_main, "render", NULL);
+    if (!render_thread_handle) {
+        fprintf(stderr, "Warning: render thread unavailable (%s); presenting inline\n", SDL_GetError());
+        return;
+    }
+    render_thread_active = 1;
+    printf("Render thread enabled\n");
+}
+
+static void render_thread_stop(void) {
+    if (!render_thread_active) {
+        return;
+    }
+    SDL_LockMutex(render_thread_lock);
+    render_thread_quit = 1;
+    SDL_CondSignal(render_thread_wake);
+    SDL_UnlockMutex(render_thread_lock);
+    SDL_WaitThread(render_thread_handle, NULL);
+    render_thread_handle = NULL;
+    render_thread_active = 0;
+}
+
+static inline void screen_mark_cell_dirty(uint16_t offset) {
+    if (offset < SCREEN_PIXEL_BYTES) {
+        // Display-file byte: bits 12-11 select the screen third, bits 7-5 the
+        // character row within it, bits 4-0 the column.
+        uint32_t row = (((offset >> 11) & 3u) << 3) | ((offset >> 5) & 7u);
+        screen_dirty_cells[row][offset & 0x1Fu] = 1u;
+    } else if (offset < SCREEN_DISPLAY_BYTES) {
+        uint16_t idx = (uint16_t)(offset - SCREEN_PIXEL_BYTES);
+        screen_dirty_cells[idx >> 5][idx & 0x1Fu] = 1u;
+    }
+}
+
 static void spectrum_map_page(int segment, SpectrumMemoryPageType type, uint8_t index) {
     if (segment < 0 || segment >= 4) {
         return;
@@ -1905,6 +2519,7 @@ static void spectrum_map_page(int segment, SpectrumMemoryPageType type, uint8_t
     if (slot->type == type && slot->index == index && slot->type != MEMORY_PAGE_NONE) {
         return;
     }
+    screen_force_full_redraw = 1;
 
     if (slot->type == MEMORY_PAGE_RAM && slot->index < 8u) {
         memcpy(ram_pages[slot->index], memory + base, 0x4000);
@@ -1936,8 +2551,22 @@ static void spectrum_refresh_visible_ram(void) {
             memcpy(memory + base, ram_pages[slot->index], 0x4000u);
         }
     }
+    screen_force_full_redraw = 1;
 }
 
+// Per-16K-segment access handlers. Uncontended segments get a direct array
+// access; the contention penalty computation only exists on the handlers
+// installed for segments that actually need it.
+typedef uint8_t (*SpectrumSegmentReadFn)(uint16_t addr);
+typedef void (*SpectrumSegmentWriteFn)(uint16_t addr, uint8_t val);
+
+static SpectrumSegmentReadFn segment_read_handlers[4] = {
+    spectrum_read_fast, spectrum_read_fast, spectrum_read_fast, spectrum_read_fast,
+};
+static SpectrumSegmentWriteFn segment_write_handlers[4] = {
+    spectrum_write_discard_fast, spectrum_write_ram_fast, spectrum_write_ram_fast, spectrum_write_ram_fast,
+};
+
 static void spectrum_update_contention_flags(void) {
     for (int segment = 0; segment < 4; ++segment) {
         uint8_t contended = 0u;
@@ -1945,11 +2574,36 @@ static void spectrum_update_contention_flags(void) {
             contended = (uint8_t)spectrum_is_ram_bank_contended(spectrum_pages[segment].index);
         }
         page_contended[segment] = contended;
+        segment_read_handlers[segment] = contended ? spectrum_read_contended : spectrum_read_fast;
+        if (segment == 0) {
+            segment_write_handlers[0] = contended ? spectrum_write_discard_contended
+                                                  : spectrum_write_discard_fast;
+        } else {
+            segment_write_handlers[segment] = contended ? spectrum_write_ram_contended
+                                                        : spectrum_write_ram_fast;
+        }
+    }
+}
+
+// Precomputed per-t-state contention delays for the active profile. Rebuilding
+// the table on profile changes turns every contended access into one indexed
+// load instead of window checks and the 8-entry pattern lookup.
+static int8_t ula_contention_delay_table[T_STATES_PER_FRAME];
+
+static void spectrum_rebuild_contention_table(void) {
+    const int* penalties = spectrum_contention_penalties[spectrum_contention_profile];
+    for (uint32_t phase = 0; phase < T_STATES_PER_FRAME; ++phase) {
+        int penalty = 0;
+        if (phase >= 14336u && phase < 57344u) {
+            penalty = penalties[phase & 7u];
+        }
+        ula_contention_delay_table[phase] = (int8_t)penalty;
     }
 }
 
 static void spectrum_set_contention_profile(SpectrumContentionProfile profile) {
     spectrum_contention_profile = profile;
+    spectrum_rebuild_contention_table();
     spectrum_update_contention_flags();
 }
 
@@ -2036,7 +2690,9 @@ static uint8_t spectrum_sample_floating_bus(uint64_t access_t_state) {
     return value;
 }
 
-static inline int ula_contention_penalty(uint64_t t_state) {
+// Reference computation of the contention pattern; kept as the oracle the
+// unit tests compare the precomputed delay table against.
+static int ula_contention_penalty_reference(uint64_t t_state) {
     uint32_t phase = (uint32_t)(t_state % T_STATES_PER_FRAME);
     if (phase < 14336u || phase >= 57344u) {
         return 0;
@@ -2045,6 +2701,10 @@ static inline int ula_contention_penalty(uint64_t t_state) {
     return penalties[phase & 7u];
 }
 
+static inline int ula_contention_penalty(uint64_t t_state) {
+    return ula_contention_delay_table[t_state % T_STATES_PER_FRAME];
+}
+
 static void spectrum_apply_memory_configuration(void) {
     if (spectrum_model == SPECTRUM_MODEL_48K) {
         current_rom_page = 0u;
@@ -2169,6 +2829,7 @@ static void spectrum_configure_model(SpectrumModel model) {
         spectrum_pages[i].type = MEMORY_PAGE_NONE;
         spectrum_pages[i].index = 0u;
     }
+    memset(rewind_bank_dirty, 1, sizeof(rewind_bank_dirty));
     if (model == SPECTRUM_MODEL_48K) {
         spectrum_contention_profile = CONTENTION_PROFILE_48K;
     } else if (model == SPECTRUM_MODEL_128K) {
@@ -2178,6 +2839,7 @@ static void spectrum_configure_model(SpectrumModel model) {
     } else {
         spectrum_contention_profile = CONTENTION_PROFILE_128K_PLUS3;
     }
+    spectrum_rebuild_contention_table();
 
     if (model == SPECTRUM_MODEL_PLUS3) {
         peripheral_contention_profile = PERIPHERAL_CONTENTION_PLUS3;
@@ -2189,24 +2851,6 @@ static void spectrum_configure_model(SpectrumModel model) {
     spectrum_log_paging_state("model configure", 0u, 0u, total_t_states);
 }
 
-static inline void apply_memory_contention(uint16_t addr) {
-    if (!ula_instruction_progress_ptr) {
-        return;
-    }
-    uint16_t page = (uint16_t)(addr >> 14);
-    if (page > 3u) {
-        return;
-    }
-    if (!page_contended[page]) {
-        return;
-    }
-    uint64_t access_t_state = spectrum_current_access_tstate();
-    int penalty = ula_contention_penalty(access_t_state);
-    if (penalty > 0) {
-        *ula_instruction_progress_ptr += penalty;
-    }
-}
-
 static inline void spectrum_write_ram_shadow(uint16_t addr, uint8_t val) {
     uint16_t page = (uint16_t)(addr >> 14);
     if (page >= 4u) {
@@ -2217,7 +2861,12 @@ static inline void spectrum_write_ram_shadow(uint16_t addr, uint8_t val) {
         return;
     }
     uint16_t base = (uint16_t)(page * 0x4000u);
-    ram_pages[slot->index][addr - base] = val;
+    uint16_t offset = (uint16_t)(addr - base);
+    ram_pages[slot->index][offset] = val;
+    rewind_bank_dirty[slot->index] = 1;
+    if (slot->index == current_screen_bank && offset < SCREEN_DISPLAY_BYTES) {
+        screen_mark_cell_dirty(offset);
+    }
 }
 
 static void spectrum_map_rom_page(uint8_t page) {
@@ -2248,20 +2897,62 @@ static void spectrum_map_upper_bank(uint8_t new_bank) {
     spectrum_apply_memory_configuration();
 }
 
-uint8_t readByte(uint16_t addr) {
-    apply_memory_contention(addr);
+static inline void spectrum_apply_contention_penalty(void) {
+    if (!ula_instruction_progress_ptr) {
+        return;
+    }
+    uint64_t access_t_state = spectrum_current_access_tstate();
+    int penalty = ula_contention_penalty(access_t_state);
+    if (penalty > 0) {
+        *ula_instruction_progress_ptr += penalty;
+    }
+}
+
+static uint8_t spectrum_read_fast(uint16_t addr) {
+    ++perf_counters.uncontended_accesses;
     return memory[addr];
 }
 
-void writeByte(uint16_t addr, uint8_t val) {
-    apply_memory_contention(addr);
-    if (addr < 0x4000u) {
-        return;
-    }
+static uint8_t spectrum_read_contended(uint16_t addr) {
+    ++perf_counters.contended_accesses;
+    spectrum_apply_contention_penalty();
+    return memory[addr];
+}
+
+static void spectrum_write_discard_fast(uint16_t addr, uint8_t val) {
+    (void)addr;
+    (void)val;
+    ++perf_counters.uncontended_accesses;
+}
+
+static void spectrum_write_discard_contended(uint16_t addr, uint8_t val) {
+    (void)addr;
+    (void)val;
+    ++perf_counters.contended_accesses;
+    spectrum_apply_contention_penalty();
+}
+
+static void spectrum_write_ram_fast(uint16_t addr, uint8_t val) {
+    ++perf_counters.uncontended_accesses;
+    memory[addr] = val;
+    spectrum_write_ram_shadow(addr, val);
+}
+
+static void spectrum_write_ram_contended(uint16_t addr, uint8_t val) {
+    ++perf_counters.contended_accesses;
+    spectrum_apply_contention_penalty();
     memory[addr] = val;
     spectrum_write_ram_shadow(addr, val);
 }
 
+uint8_t readByte(uint16_t addr) {
+    return segment_read_handlers[addr >> 14](addr);
+}
+
+void writeByte(uint16_t addr, uint8_t val) {
+    segment_write_handlers[addr >> 14](addr, val);
+}
+
 uint16_t readWord(uint16_t addr) {
     uint8_t lo = readByte(addr);
     uint8_t hi = readByte((uint16_t)(addr + 1u));
@@ -2368,13 +3059,8 @@ static double beeper_current_latency_samples(void) {
         return 0.0;
     }
 
-    double writer_cursor;
-    double playback_position;
-
-    SDL_LockAudio();
-    writer_cursor = beeper_writer_cursor;
-    playback_position = beeper_playback_position;
-    SDL_UnlockAudio();
+    double writer_cursor = beeper_writer_cursor;
+    double playback_position = beeper_playback_position;
 
     double latency_cycles = writer_cursor - playback_position;
     if (latency_cycles <= 0.0) {
@@ -2491,11 +3177,31 @@ static int audio_dump_start(const char* path, uint32_t sample_rate, uint16_t cha
         return 0;
     }
 
+    // Preallocate the ring and hand the file to the writer thread so the
+    // audio callback never touches the disk. If the thread cannot start,
+    // fall back to the old synchronous writes.
+    audio_dump_ring = (Sint16*)malloc(AUDIO_DUMP_RING_SAMPLES * sizeof(Sint16));
+    if (audio_dump_ring) {
+        atomic_store_explicit(&audio_dump_ring_head, 0, memory_order_relaxed);
+        atomic_store_explicit(&audio_dump_ring_tail, 0, memory_order_relaxed);
+        atomic_store_explicit(&audio_dump_writer_stop, 0, memory_order_relaxed);
+        atomic_store_explicit(&audio_dump_active, 1, memory_order_release);
+        audio_dump_dropped_samples = 0;
+        audio_dump_writer_thread = SDL_CreateThread(audio_dump_writer_main, "audio-dump", NULL);
+    }
+    if (!audio_dump_writer_thread) {
+        fprintf(stderr, "[BEEPER] audio dump writer thread unavailable; writing synchronously\n");
+        atomic_store_explicit(&audio_dump_active, 0, memory_order_release);
+        free(audio_dump_ring);
+        audio_dump_ring = NULL;
+    }
+
     BEEPER_LOG("[BEEPER] dumping audio to %s\n", path);
     return 1;
 }
 
 static void audio_dump_abort(void) {
+    atomic_store_explicit(&audio_dump_active, 0, memory_order_release);
     if (audio_dump_file) {
         fclose(audio_dump_file);
         audio_dump_file = NULL;
@@ -2503,42 +3209,138 @@ static void audio_dump_abort(void) {
     audio_dump_data_bytes = 0;
 }
 
-static void audio_dump_write_samples(const Sint16* samples, size_t count) {
-    if (!audio_dump_file || !samples || count == 0) {
-        return;
+// Drains one contiguous span of the ring to disk. Returns the number of
+// samples written, or -1 on a write failure.
+static long audio_dump_writer_drain(void) {
+    size_t tail = atomic_load_explicit(&audio_dump_ring_tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&audio_dump_ring_head, memory_order_acquire);
+    if (tail == head) {
+        return 0;
+    }
+
+    size_t available = (head - tail) & (AUDIO_DUMP_RING_SAMPLES - 1u);
+    size_t span = AUDIO_DUMP_RING_SAMPLES - (tail & (AUDIO_DUMP_RING_SAMPLES - 1u));
+    if (span > available) {
+        span = available;
+    }
+    if (span > AUDIO_DUMP_WRITE_CHUNK_SAMPLES) {
+        span = AUDIO_DUMP_WRITE_CHUNK_SAMPLES;
     }
 
-    size_t written = fwrite(samples, sizeof(Sint16), count, audio_dump_file);
-    if (written != count) {
+    const Sint16* src = &audio_dump_ring[tail & (AUDIO_DUMP_RING_SAMPLES - 1u)];
+    size_t written = fwrite(src, sizeof(Sint16), span, audio_dump_file);
+    if (written != span) {
         fprintf(stderr,
                 "[BEEPER] audio dump write failed after %zu samples\n",
                 (size_t)(audio_dump_data_bytes / 2u));
-        audio_dump_abort();
-        return;
+        return -1;
     }
 
     audio_dump_data_bytes += (uint32_t)(written * sizeof(Sint16));
+    atomic_store_explicit(&audio_dump_ring_tail, tail + span, memory_order_release);
+    return (long)span;
 }
 
-static void audio_dump_finish(void) {
-    if (!audio_dump_file) {
-        return;
+static int audio_dump_writer_main(void* data) {
+    (void)data;
+    for (;;) {
+        long drained = audio_dump_writer_drain();
+        if (drained < 0) {
+            // Stop capturing but keep consuming nothing: the callback sees
+            // active drop to zero and goes quiet.
+            atomic_store_explicit(&audio_dump_active, 0, memory_order_release);
+            return 0;
+        }
+        if (drained == 0) {
+            if (atomic_load_explicit(&audio_dump_writer_stop, memory_order_acquire)) {
+                return 0; // ring fully drained
+            }
+            SDL_Delay(4);
+        }
     }
+}
 
-    uint32_t riff_size = 36u + audio_dump_data_bytes;
-    uint32_t data_size = audio_dump_data_bytes;
-
-    if (fseek(audio_dump_file, 4L, SEEK_SET) == 0) {
-        uint8_t size_bytes[4];
-        audio_dump_write_uint32(size_bytes, riff_size);
-        fwrite(size_bytes, sizeof(size_bytes), 1, audio_dump_file);
+static void audio_dump_write_samples(const Sint16* samples, size_t count) {
+    if (!samples || count == 0) {
+        return;
     }
 
-    if (fseek(audio_dump_file, 40L, SEEK_SET) == 0) {
-        uint8_t data_bytes_buf[4];
-        audio_dump_write_uint32(data_bytes_buf, data_size);
-        fwrite(data_bytes_buf, sizeof(data_bytes_buf), 1, audio_dump_file);
-    }
+    if (!audio_dump_writer_thread) {
+        // No writer thread (startup failure): write synchronously as before.
+        if (!audio_dump_file) {
+            return;
+        }
+        size_t written = fwrite(samples, sizeof(Sint16), count, audio_dump_file);
+        if (written != count) {
+            fprintf(stderr,
+                    "[BEEPER] audio dump write failed after %zu samples\n",
+                    (size_t)(audio_dump_data_bytes / 2u));
+            audio_dump_abort();
+            return;
+        }
+        audio_dump_data_bytes += (uint32_t)(written * sizeof(Sint16));
+        return;
+    }
+
+    if (!atomic_load_explicit(&audio_dump_active, memory_order_acquire)) {
+        return;
+    }
+
+    size_t head = atomic_load_explicit(&audio_dump_ring_head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&audio_dump_ring_tail, memory_order_acquire);
+    size_t used = (head - tail) & (AUDIO_DUMP_RING_SAMPLES - 1u);
+    size_t free_samples = AUDIO_DUMP_RING_SAMPLES - 1u - used;
+    if (count > free_samples) {
+        audio_dump_dropped_samples += count - free_samples;
+        count = free_samples;
+    }
+
+    size_t index = head & (AUDIO_DUMP_RING_SAMPLES - 1u);
+    size_t first = AUDIO_DUMP_RING_SAMPLES - index;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(&audio_dump_ring[index], samples, first * sizeof(Sint16));
+    if (count > first) {
+        memcpy(&audio_dump_ring[0], samples + first, (count - first) * sizeof(Sint16));
+    }
+    atomic_store_explicit(&audio_dump_ring_head, head + count, memory_order_release);
+}
+
+static void audio_dump_finish(void) {
+    if (audio_dump_writer_thread) {
+        atomic_store_explicit(&audio_dump_writer_stop, 1, memory_order_release);
+        SDL_WaitThread(audio_dump_writer_thread, NULL);
+        audio_dump_writer_thread = NULL;
+    }
+    atomic_store_explicit(&audio_dump_active, 0, memory_order_release);
+    free(audio_dump_ring);
+    audio_dump_ring = NULL;
+    if (audio_dump_dropped_samples > 0) {
+        fprintf(stderr,
+                "[BEEPER] audio dump dropped %" PRIu64 " samples (disk too slow)\n",
+                audio_dump_dropped_samples);
+        audio_dump_dropped_samples = 0;
+    }
+
+    if (!audio_dump_file) {
+        return;
+    }
+
+    uint32_t riff_size = 36u + audio_dump_data_bytes;
+    uint32_t data_size = audio_dump_data_bytes;
+
+    if (fseek(audio_dump_file, 4L, SEEK_SET) == 0) {
+        uint8_t size_bytes[4];
+        audio_dump_write_uint32(size_bytes, riff_size);
+        fwrite(size_bytes, sizeof(size_bytes), 1, audio_dump_file);
+    }
+
+    if (fseek(audio_dump_file, 40L, SEEK_SET) == 0) {
+        uint8_t data_bytes_buf[4];
+        audio_dump_write_uint32(data_bytes_buf, data_size);
+        fwrite(data_bytes_buf, sizeof(data_bytes_buf), 1, audio_dump_file);
+    }
 
     fclose(audio_dump_file);
     audio_dump_file = NULL;
@@ -2659,24 +3461,89 @@ static void tape_log_block_summary(const TapeBlock* block, size_t index) {
     }
 }
 
-static void tape_free_image(TapeImage* image) {
-    if (!image) {
+static void tape_arena_release(TapeArena* arena) {
+    if (!arena) {
         return;
     }
-    if (image->blocks) {
-        for (size_t i = 0; i < image->count; ++i) {
-            free(image->blocks[i].data);
-            image->blocks[i].data = NULL;
-            free(image->blocks[i].pulse_sequence_durations);
-            image->blocks[i].pulse_sequence_durations = NULL;
-            free(image->blocks[i].direct_samples);
-            image->blocks[i].direct_samples = NULL;
+    TapeArenaSlab* slab = arena->head;
+    while (slab) {
+        TapeArenaSlab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    arena->head = NULL;
+}
+
+static void* tape_arena_alloc(TapeArena* arena, size_t size) {
+    if (!arena || size == 0) {
+        return NULL;
+    }
+    size_t aligned = (size + 7u) & ~(size_t)7u;
+    TapeArenaSlab* slab = arena->head;
+    if (!slab || slab->capacity - slab->used < aligned) {
+        size_t capacity = aligned > TAPE_ARENA_SLAB_BYTES ? aligned : TAPE_ARENA_SLAB_BYTES;
+        slab = (TapeArenaSlab*)malloc(sizeof(TapeArenaSlab) + capacity);
+        if (!slab) {
+            return NULL;
         }
-        free(image->blocks);
+        slab->next = arena->head;
+        slab->capacity = capacity;
+        slab->used = 0;
+        arena->head = slab;
+    }
+    void* ptr = (uint8_t*)(slab + 1) + slab->used;
+    slab->used += aligned;
+    return ptr;
+}
+
+// Grows the most recent allocation in place while it still sits at the end of
+// the head slab; otherwise carves a fresh region and copies. The abandoned
+// region stays in its slab until the arena is released.
+static void* tape_arena_grow(TapeArena* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!arena || new_size == 0) {
+        return NULL;
+    }
+    if (!ptr || old_size == 0) {
+        return tape_arena_alloc(arena, new_size);
+    }
+    size_t old_aligned = (old_size + 7u) & ~(size_t)7u;
+    size_t new_aligned = (new_size + 7u) & ~(size_t)7u;
+    TapeArenaSlab* slab = arena->head;
+    if (slab && (uint8_t*)ptr + old_aligned == (uint8_t*)(slab + 1) + slab->used &&
+        slab->used - old_aligned + new_aligned <= slab->capacity) {
+        slab->used = slab->used - old_aligned + new_aligned;
+        return ptr;
+    }
+    void* grown = tape_arena_alloc(arena, new_size);
+    if (!grown) {
+        return NULL;
+    }
+    memcpy(grown, ptr, old_size < new_size ? old_size : new_size);
+    return grown;
+}
+
+static void tape_free_image(TapeImage* image) {
+    if (!image) {
+        return;
     }
+    tape_arena_release(&image->arena);
     image->blocks = NULL;
     image->count = 0;
     image->capacity = 0;
+    if (image->backing) {
+#ifdef _WIN32
+        free(image->backing);
+#else
+        if (image->backing_is_mapped) {
+            munmap(image->backing, image->backing_size);
+        } else {
+            free(image->backing);
+        }
+#endif
+    }
+    image->backing = NULL;
+    image->backing_size = 0;
+    image->backing_is_mapped = 0;
 }
 
 static TapeBlock* tape_image_new_block(TapeImage* image) {
@@ -2686,7 +3553,10 @@ static TapeBlock* tape_image_new_block(TapeImage* image) {
 
     if (image->count == image->capacity) {
         size_t new_capacity = image->capacity ? image->capacity * 2 : 8;
-        TapeBlock* new_blocks = (TapeBlock*)realloc(image->blocks, new_capacity * sizeof(TapeBlock));
+        TapeBlock* new_blocks = (TapeBlock*)tape_arena_grow(&image->arena,
+                                                            image->blocks,
+                                                            image->capacity * sizeof(TapeBlock),
+                                                            new_capacity * sizeof(TapeBlock));
         if (!new_blocks) {
             return NULL;
         }
@@ -2716,10 +3586,14 @@ static TapeBlock* tape_image_new_block(TapeImage* image) {
     block->direct_samples = NULL;
     block->direct_sample_count = 0u;
     block->direct_initial_level = 1;
+    block->data_is_reference = 0u;
+    block->direct_samples_is_reference = 0u;
     return block;
 }
 
-static int tape_image_add_block(TapeImage* image, const uint8_t* data, uint32_t length, uint32_t pause_ms) {
+// With copy_data zero the block references the caller's buffer (the image
+// backing) instead of duplicating it; the payload must outlive the image.
+static int tape_image_add_block(TapeImage* image, const uint8_t* data, uint32_t length, uint32_t pause_ms, int copy_data) {
     TapeBlock* block = tape_image_new_block(image);
     if (!block) {
         return 0;
@@ -2730,11 +3604,16 @@ static int tape_image_add_block(TapeImage* image, const uint8_t* data, uint32_t
     block->pause_ms = pause_ms;
 
     if (length > 0) {
-        block->data = (uint8_t*)malloc(length);
-        if (!block->data) {
-            return 0;
+        if (copy_data) {
+            block->data = (uint8_t*)tape_arena_alloc(&image->arena, length);
+            if (!block->data) {
+                return 0;
+            }
+            memcpy(block->data, data, length);
+        } else {
+            block->data = (uint8_t*)data;
+            block->data_is_reference = 1u;
         }
-        memcpy(block->data, data, length);
     }
 
     tape_log_block_summary(block, image->count);
@@ -2754,7 +3633,8 @@ static int tape_image_add_turbo_block(TapeImage* image,
                                       uint16_t bit0_second,
                                       uint16_t bit1_first,
                                       uint16_t bit1_second,
-                                      uint8_t used_bits) {
+                                      uint8_t used_bits,
+                                      int copy_data) {
     TapeBlock* block = tape_image_new_block(image);
     if (!block) {
         return 0;
@@ -2774,11 +3654,16 @@ static int tape_image_add_turbo_block(TapeImage* image,
     block->used_bits_in_last_byte = (used_bits == 0u) ? 8u : used_bits;
 
     if (length > 0u) {
-        block->data = (uint8_t*)malloc(length);
-        if (!block->data) {
-            return 0;
+        if (copy_data) {
+            block->data = (uint8_t*)tape_arena_alloc(&image->arena, length);
+            if (!block->data) {
+                return 0;
+            }
+            memcpy(block->data, data, length);
+        } else {
+            block->data = (uint8_t*)data;
+            block->data_is_reference = 1u;
         }
-        memcpy(block->data, data, length);
     }
 
     tape_log_block_summary(block, image->count);
@@ -2794,7 +3679,8 @@ static int tape_image_add_pure_data_block(TapeImage* image,
                                           uint16_t bit0_second,
                                           uint16_t bit1_first,
                                           uint16_t bit1_second,
-                                          uint8_t used_bits) {
+                                          uint8_t used_bits,
+                                          int copy_data) {
     return tape_image_add_turbo_block(image,
                                       data,
                                       length,
@@ -2807,7 +3693,8 @@ static int tape_image_add_pure_data_block(TapeImage* image,
                                       bit0_second,
                                       bit1_first,
                                       bit1_second,
-                                      used_bits);
+                                      used_bits,
+                                      copy_data);
 }
 
 static int tape_image_add_pure_tone_block(TapeImage* image,
@@ -2843,7 +3730,7 @@ static int tape_image_add_pulse_sequence_block(TapeImage* image,
 
     if (count > 0u) {
         size_t bytes = count * sizeof(uint16_t);
-        block->pulse_sequence_durations = (uint16_t*)malloc(bytes);
+        block->pulse_sequence_durations = (uint16_t*)tape_arena_alloc(&image->arena, bytes);
         if (!block->pulse_sequence_durations) {
             return 0;
         }
@@ -2861,7 +3748,8 @@ static int tape_image_add_direct_recording_block(TapeImage* image,
                                                  const uint8_t* samples,
                                                  uint32_t sample_bytes,
                                                  uint8_t used_bits,
-                                                 uint32_t pause_ms) {
+                                                 uint32_t pause_ms,
+                                                 int copy_data) {
     TapeBlock* block = tape_image_new_block(image);
     if (!block) {
         return 0;
@@ -2873,11 +3761,16 @@ static int tape_image_add_direct_recording_block(TapeImage* image,
     block->used_bits_in_last_byte = (used_bits == 0u) ? 8u : used_bits;
 
     if (sample_bytes > 0u) {
-        block->direct_samples = (uint8_t*)malloc(sample_bytes);
-        if (!block->direct_samples) {
-            return 0;
+        if (copy_data) {
+            block->direct_samples = (uint8_t*)tape_arena_alloc(&image->arena, sample_bytes);
+            if (!block->direct_samples) {
+                return 0;
+            }
+            memcpy(block->direct_samples, samples, sample_bytes);
+        } else {
+            block->direct_samples = (uint8_t*)samples;
+            block->direct_samples_is_reference = 1u;
         }
-        memcpy(block->direct_samples, samples, sample_bytes);
     }
 
     uint32_t total_bits = sample_bytes * 8u;
@@ -2900,14 +3793,17 @@ static void tape_waveform_reset(TapeWaveform* waveform) {
     if (!waveform) {
         return;
     }
-    if (waveform->pulses) {
-        free(waveform->pulses);
-        waveform->pulses = NULL;
-    }
+    tape_arena_release(&waveform->arena);
+    waveform->pulses = NULL;
     waveform->count = 0;
     waveform->capacity = 0;
     waveform->initial_level = 1;
     waveform->sample_rate = 0u;
+    waveform->streaming = 0;
+    waveform->window_base = 0;
+    waveform->stream_next_block = 0;
+    waveform->stream_pending_silence = 0;
+    waveform->stream_done = 0;
 }
 
 static int tape_waveform_add_pulse(TapeWaveform* waveform, uint64_t duration) {
@@ -2919,7 +3815,10 @@ static int tape_waveform_add_pulse(TapeWaveform* waveform, uint64_t duration) {
     }
     if (waveform->count == waveform->capacity) {
         size_t new_capacity = waveform->capacity ? waveform->capacity * 2 : 512;
-        TapePulse* new_pulses = (TapePulse*)realloc(waveform->pulses, new_capacity * sizeof(TapePulse));
+        TapePulse* new_pulses = (TapePulse*)tape_arena_grow(&waveform->arena,
+                                                            waveform->pulses,
+                                                            waveform->capacity * sizeof(TapePulse),
+                                                            new_capacity * sizeof(TapePulse));
         if (!new_pulses) {
             return 0;
         }
@@ -2941,338 +3840,554 @@ static int tape_waveform_add_with_pending(TapeWaveform* waveform,
     return tape_waveform_add_pulse(waveform, duration);
 }
 
-static int tape_generate_waveform_from_image(const TapeImage* image, TapeWaveform* waveform) {
-    if (!image || !waveform) {
+static int tape_waveform_expand_block(TapeWaveform* waveform, const TapeBlock* block, uint64_t* pending_silence_io) {
+    if (!waveform || !block || !pending_silence_io) {
         return 0;
     }
 
-    tape_waveform_reset(waveform);
-    waveform->initial_level = 1;
-    waveform->sample_rate = 0u;
-
-    if (image->count == 0) {
-        return 1;
-    }
-
-    uint64_t pending_silence = 0;
-    if (waveform->count == 0) {
-        waveform->initial_level = 1;
-    }
-    for (size_t block_index = 0; block_index < image->count; ++block_index) {
-        const TapeBlock* block = &image->blocks[block_index];
-        switch (block->type) {
-            case TAPE_BLOCK_TYPE_STANDARD:
-            case TAPE_BLOCK_TYPE_TURBO:
-            case TAPE_BLOCK_TYPE_PURE_DATA: {
-                uint32_t pilot_count = 0u;
-                uint16_t pilot_pulse = block->pilot_pulse_tstates;
-                uint16_t sync1 = block->sync_first_pulse_tstates;
-                uint16_t sync2 = block->sync_second_pulse_tstates;
-                uint16_t bit0_first = block->bit0_first_pulse_tstates;
-                uint16_t bit0_second = block->bit0_second_pulse_tstates;
-                uint16_t bit1_first = block->bit1_first_pulse_tstates;
-                uint16_t bit1_second = block->bit1_second_pulse_tstates;
-
-                if (block->type == TAPE_BLOCK_TYPE_STANDARD) {
-                    if (block->length > 0 && block->data && block->data[0] == 0x00) {
-                        pilot_count = (uint32_t)TAPE_HEADER_PILOT_COUNT;
-                    } else {
-                        pilot_count = (uint32_t)TAPE_DATA_PILOT_COUNT;
-                    }
-                    pilot_pulse = (uint16_t)TAPE_PILOT_PULSE_TSTATES;
-                    sync1 = (uint16_t)TAPE_SYNC_FIRST_PULSE_TSTATES;
-                    sync2 = (uint16_t)TAPE_SYNC_SECOND_PULSE_TSTATES;
-                    bit0_first = (uint16_t)TAPE_BIT0_PULSE_TSTATES;
-                    bit0_second = (uint16_t)TAPE_BIT0_PULSE_TSTATES;
-                    bit1_first = (uint16_t)TAPE_BIT1_PULSE_TSTATES;
-                    bit1_second = (uint16_t)TAPE_BIT1_PULSE_TSTATES;
+    uint64_t pending_silence = *pending_silence_io;
+    switch (block->type) {
+        case TAPE_BLOCK_TYPE_STANDARD:
+        case TAPE_BLOCK_TYPE_TURBO:
+        case TAPE_BLOCK_TYPE_PURE_DATA: {
+            uint32_t pilot_count = 0u;
+            uint16_t pilot_pulse = block->pilot_pulse_tstates;
+            uint16_t sync1 = block->sync_first_pulse_tstates;
+            uint16_t sync2 = block->sync_second_pulse_tstates;
+            uint16_t bit0_first = block->bit0_first_pulse_tstates;
+            uint16_t bit0_second = block->bit0_second_pulse_tstates;
+            uint16_t bit1_first = block->bit1_first_pulse_tstates;
+            uint16_t bit1_second = block->bit1_second_pulse_tstates;
+
+            if (block->type == TAPE_BLOCK_TYPE_STANDARD) {
+                if (block->length > 0 && block->data && block->data[0] == 0x00) {
+                    pilot_count = (uint32_t)TAPE_HEADER_PILOT_COUNT;
                 } else {
-                    pilot_count = block->pilot_pulse_count;
+                    pilot_count = (uint32_t)TAPE_DATA_PILOT_COUNT;
                 }
+                pilot_pulse = (uint16_t)TAPE_PILOT_PULSE_TSTATES;
+                sync1 = (uint16_t)TAPE_SYNC_FIRST_PULSE_TSTATES;
+                sync2 = (uint16_t)TAPE_SYNC_SECOND_PULSE_TSTATES;
+                bit0_first = (uint16_t)TAPE_BIT0_PULSE_TSTATES;
+                bit0_second = (uint16_t)TAPE_BIT0_PULSE_TSTATES;
+                bit1_first = (uint16_t)TAPE_BIT1_PULSE_TSTATES;
+                bit1_second = (uint16_t)TAPE_BIT1_PULSE_TSTATES;
+            } else {
+                pilot_count = block->pilot_pulse_count;
+            }
 
-                for (uint32_t pulse = 0; pulse < pilot_count; ++pulse) {
-                    uint64_t duration = (uint64_t)pilot_pulse;
-                    if (!tape_waveform_add_with_pending(waveform, duration, &pending_silence)) {
-                        return 0;
-                    }
+            for (uint32_t pulse = 0; pulse < pilot_count; ++pulse) {
+                uint64_t duration = (uint64_t)pilot_pulse;
+                if (!tape_waveform_add_with_pending(waveform, duration, &pending_silence)) {
+                    return 0;
                 }
+            }
 
-                if (sync1 > 0u) {
-                    if (!tape_waveform_add_with_pending(waveform, (uint64_t)sync1, &pending_silence)) {
-                        return 0;
-                    }
+            if (sync1 > 0u) {
+                if (!tape_waveform_add_with_pending(waveform, (uint64_t)sync1, &pending_silence)) {
+                    return 0;
                 }
+            }
 
-                if (sync2 > 0u) {
-                    if (!tape_waveform_add_pulse(waveform, (uint64_t)sync2)) {
-                        return 0;
-                    }
+            if (sync2 > 0u) {
+                if (!tape_waveform_add_pulse(waveform, (uint64_t)sync2)) {
+                    return 0;
                 }
+            }
 
-                if (block->length > 0 && block->data) {
-                    for (uint32_t byte_index = 0; byte_index < block->length; ++byte_index) {
-                        uint8_t value = block->data[byte_index];
-                        uint8_t mask = 0x80u;
-                        uint8_t bits_to_emit = 8u;
-                        if (byte_index == block->length - 1u) {
-                            uint8_t used_bits = block->used_bits_in_last_byte;
-                            if (used_bits > 0u && used_bits < 8u) {
-                                bits_to_emit = used_bits;
-                            }
+            if (block->length > 0 && block->data) {
+                for (uint32_t byte_index = 0; byte_index < block->length; ++byte_index) {
+                    uint8_t value = block->data[byte_index];
+                    uint8_t mask = 0x80u;
+                    uint8_t bits_to_emit = 8u;
+                    if (byte_index == block->length - 1u) {
+                        uint8_t used_bits = block->used_bits_in_last_byte;
+                        if (used_bits > 0u && used_bits < 8u) {
+                            bits_to_emit = used_bits;
                         }
-                        for (uint8_t bit = 0u; bit < bits_to_emit; ++bit) {
-                            int is_one = (value & mask) ? 1 : 0;
-                            uint16_t first = is_one ? bit1_first : bit0_first;
-                            uint16_t second = is_one ? bit1_second : bit0_second;
-                            if (!tape_waveform_add_with_pending(waveform, (uint64_t)first, &pending_silence)) {
-                                return 0;
-                            }
-                            if (!tape_waveform_add_pulse(waveform, (uint64_t)second)) {
-                                return 0;
-                            }
-                            mask >>= 1;
+                    }
+                    for (uint8_t bit = 0u; bit < bits_to_emit; ++bit) {
+                        int is_one = (value & mask) ? 1 : 0;
+                        uint16_t first = is_one ? bit1_first : bit0_first;
+                        uint16_t second = is_one ? bit1_second : bit0_second;
+                        if (!tape_waveform_add_with_pending(waveform, (uint64_t)first, &pending_silence)) {
+                            return 0;
+                        }
+                        if (!tape_waveform_add_pulse(waveform, (uint64_t)second)) {
+                            return 0;
                         }
+                        mask >>= 1;
                     }
                 }
-                break;
             }
-            case TAPE_BLOCK_TYPE_PURE_TONE: {
-                uint32_t pulse_count = block->tone_pulse_count;
-                for (uint32_t i = 0; i < pulse_count; ++i) {
-                    if (!tape_waveform_add_with_pending(waveform, (uint64_t)block->tone_pulse_tstates, &pending_silence)) {
-                        return 0;
-                    }
+            break;
+        }
+        case TAPE_BLOCK_TYPE_PURE_TONE: {
+            uint32_t pulse_count = block->tone_pulse_count;
+            for (uint32_t i = 0; i < pulse_count; ++i) {
+                if (!tape_waveform_add_with_pending(waveform, (uint64_t)block->tone_pulse_tstates, &pending_silence)) {
+                    return 0;
                 }
-                break;
             }
-            case TAPE_BLOCK_TYPE_PULSE_SEQUENCE: {
-                for (size_t i = 0; i < block->pulse_sequence_count; ++i) {
-                    uint64_t duration = (uint64_t)block->pulse_sequence_durations[i];
-                    if (!tape_waveform_add_with_pending(waveform, duration, &pending_silence)) {
-                        return 0;
-                    }
+            break;
+        }
+        case TAPE_BLOCK_TYPE_PULSE_SEQUENCE: {
+            for (size_t i = 0; i < block->pulse_sequence_count; ++i) {
+                uint64_t duration = (uint64_t)block->pulse_sequence_durations[i];
+                if (!tape_waveform_add_with_pending(waveform, duration, &pending_silence)) {
+                    return 0;
                 }
-                break;
             }
-            case TAPE_BLOCK_TYPE_DIRECT_RECORDING: {
-                if (block->direct_sample_count > 0u && block->direct_samples) {
-                    uint32_t samples = block->direct_sample_count;
-                    uint32_t tstates_per_sample = block->direct_tstates_per_sample ? block->direct_tstates_per_sample : 1u;
-                    int current_level = block->direct_initial_level ? 1 : 0;
-                    if (waveform->count == 0) {
-                        waveform->initial_level = current_level;
+            break;
+        }
+        case TAPE_BLOCK_TYPE_DIRECT_RECORDING: {
+            if (block->direct_sample_count > 0u && block->direct_samples) {
+                uint32_t samples = block->direct_sample_count;
+                uint32_t tstates_per_sample = block->direct_tstates_per_sample ? block->direct_tstates_per_sample : 1u;
+                int current_level = block->direct_initial_level ? 1 : 0;
+                if (waveform->count == 0) {
+                    waveform->initial_level = current_level;
+                }
+                uint64_t run_length = 0;
+                for (uint32_t sample_index = 0; sample_index < samples; ++sample_index) {
+                    uint32_t byte_index = sample_index / 8u;
+                    uint32_t bit_index = 7u - (sample_index % 8u);
+                    int level = (block->direct_samples[byte_index] >> bit_index) & 0x01;
+                    if (sample_index == 0) {
+                        current_level = level;
+                        run_length = (uint64_t)tstates_per_sample;
+                        continue;
                     }
-                    uint64_t run_length = 0;
-                    for (uint32_t sample_index = 0; sample_index < samples; ++sample_index) {
-                        uint32_t byte_index = sample_index / 8u;
-                        uint32_t bit_index = 7u - (sample_index % 8u);
-                        int level = (block->direct_samples[byte_index] >> bit_index) & 0x01;
-                        if (sample_index == 0) {
-                            current_level = level;
-                            run_length = (uint64_t)tstates_per_sample;
-                            continue;
-                        }
-                        if (level == current_level) {
-                            run_length += (uint64_t)tstates_per_sample;
-                        } else {
-                            if (!tape_waveform_add_with_pending(waveform, run_length, &pending_silence)) {
-                                return 0;
-                            }
-                            current_level = level;
-                            run_length = (uint64_t)tstates_per_sample;
+                    if (level == current_level) {
+                        run_length += (uint64_t)tstates_per_sample;
+                    } else {
+                        if (!tape_waveform_add_with_pending(waveform, run_length, &pending_silence)) {
+                            return 0;
                         }
+                        current_level = level;
+                        run_length = (uint64_t)tstates_per_sample;
                     }
-                    pending_silence += run_length;
                 }
-                break;
+                pending_silence += run_length;
             }
+            break;
         }
-
-        pending_silence += tape_pause_to_tstates(block->pause_ms);
     }
 
+    pending_silence += tape_pause_to_tstates(block->pause_ms);
+    *pending_silence_io = pending_silence;
     return 1;
 }
 
-static int tape_load_tap(const char* path, TapeImage* image) {
-    FILE* tf = fopen(path, "rb");
-    if (!tf) {
-        fprintf(stderr, "Failed to open TAP file '%s': %s\n", path, strerror(errno));
+static int tape_generate_waveform_from_image(const TapeImage* image, TapeWaveform* waveform) {
+    if (!image || !waveform) {
         return 0;
     }
 
-    uint8_t length_bytes[2];
-    while (fread(length_bytes, sizeof(length_bytes), 1, tf) == 1) {
-        uint32_t block_length = (uint32_t)length_bytes[0] | ((uint32_t)length_bytes[1] << 8);
-        uint8_t* buffer = NULL;
-        if (block_length > 0) {
-            buffer = (uint8_t*)malloc(block_length);
-            if (!buffer) {
-                fprintf(stderr, "Out of memory while reading TAP block\n");
-                fclose(tf);
-                return 0;
-            }
-            if (fread(buffer, block_length, 1, tf) != 1) {
-                fprintf(stderr, "Failed to read TAP block payload\n");
-                free(buffer);
-                fclose(tf);
-                return 0;
-            }
-        }
+    tape_waveform_reset(waveform);
 
-        uint32_t pause_ms = 1000u;
-        if (buffer) {
-            if (!tape_image_add_block(image, buffer, block_length, pause_ms)) {
-                fprintf(stderr, "Failed to store TAP block\n");
-                free(buffer);
-                fclose(tf);
-                return 0;
-            }
-            free(buffer);
-        } else {
-            uint8_t empty = 0;
-            if (!tape_image_add_block(image, &empty, 0u, pause_ms)) {
-                fprintf(stderr, "Failed to store empty TAP block\n");
-                fclose(tf);
-                return 0;
-            }
+    uint64_t pending_silence = 0;
+    for (size_t block_index = 0; block_index < image->count; ++block_index) {
+        if (!tape_waveform_expand_block(waveform, &image->blocks[block_index], &pending_silence)) {
+            return 0;
         }
     }
 
-    if (!feof(tf)) {
-        fprintf(stderr, "Failed to read TAP file '%s' completely\n", path);
-        fclose(tf);
+    return 1;
+}
+
+static void tape_free_block_index(TapePlaybackState* state) {
+    if (!state) {
+        return;
+    }
+    free(state->block_index);
+    state->block_index = NULL;
+    state->block_index_count = 0;
+}
+
+// Builds the per-block seek index by running each block through the same
+// expansion the waveform generator uses, into a scratch window that is reset
+// between blocks. Pulse counts and durations therefore match the real
+// waveform exactly, including silence folded into the next block's first
+// pulse, without materialising the whole tape.
+static int tape_build_block_index(TapePlaybackState* state) {
+    if (!state) {
         return 0;
     }
+    tape_free_block_index(state);
+    if (state->image.count == 0) {
+        return 1;
+    }
 
-    fclose(tf);
-    if (tape_debug_logging) {
-        tape_log("Loaded TAP '%s' with %zu blocks\n", path, image->count);
+    TapeBlockIndexEntry* entries =
+        (TapeBlockIndexEntry*)malloc(state->image.count * sizeof(TapeBlockIndexEntry));
+    if (!entries) {
+        return 0;
+    }
+
+    TapeWaveform scratch = {0};
+    uint64_t pending_silence = 0;
+    uint64_t pulse_cursor = 0;
+    uint64_t tstate_cursor = 0;
+    for (size_t block_index = 0; block_index < state->image.count; ++block_index) {
+        entries[block_index].start_pulse = pulse_cursor;
+        entries[block_index].start_tstates = tstate_cursor;
+        scratch.count = 0; // reuse the scratch buffer, keep its capacity
+        if (!tape_waveform_expand_block(&scratch, &state->image.blocks[block_index], &pending_silence)) {
+            tape_waveform_reset(&scratch);
+            free(entries);
+            return 0;
+        }
+        for (size_t i = 0; i < scratch.count; ++i) {
+            tstate_cursor += (uint64_t)scratch.pulses[i].duration;
+        }
+        pulse_cursor += scratch.count;
     }
+    tape_waveform_reset(&scratch);
+
+    state->block_index = entries;
+    state->block_index_count = state->image.count;
     return 1;
 }
 
-static int tape_load_tzx(const char* path, TapeImage* image) {
-    FILE* tf = fopen(path, "rb");
-    if (!tf) {
-        fprintf(stderr, "Failed to open TZX file '%s': %s\n", path, strerror(errno));
-        return 0;
+static void tape_waveform_stream_restart(TapeWaveform* waveform) {
+    if (!waveform) {
+        return;
     }
+    waveform->count = 0;
+    waveform->window_base = 0;
+    waveform->initial_level = 1;
+    waveform->stream_next_block = 0;
+    waveform->stream_pending_silence = 0;
+    waveform->stream_done = 0;
+}
 
-    uint8_t header[10];
-    if (fread(header, sizeof(header), 1, tf) != 1) {
-        fprintf(stderr, "Failed to read TZX header from '%s'\n", path);
-        fclose(tf);
+// Starts a streamed expansion of the image and primes the window with the
+// first audible block so callers can keep treating count > 0 as "has audio".
+static int tape_waveform_stream_init(const TapeImage* image, TapeWaveform* waveform) {
+    if (!image || !waveform) {
         return 0;
     }
 
-    if (memcmp(header, "ZXTape!\x1A", 8) != 0) {
-        fprintf(stderr, "File '%s' is not a valid TZX image\n", path);
-        fclose(tf);
-        return 0;
+    tape_waveform_reset(waveform);
+    waveform->streaming = 1;
+    tape_waveform_stream_restart(waveform);
+
+    while (waveform->count == 0 && waveform->stream_next_block < image->count) {
+        if (!tape_waveform_expand_block(waveform,
+                                        &image->blocks[waveform->stream_next_block],
+                                        &waveform->stream_pending_silence)) {
+            return 0;
+        }
+        waveform->stream_next_block++;
+    }
+    if (waveform->stream_next_block >= image->count) {
+        waveform->stream_done = 1;
     }
+    return 1;
+}
 
-    int block_id = 0;
-    while ((block_id = fgetc(tf)) != EOF) {
-        if (block_id == 0x10) {
-            uint8_t pause_bytes[2];
-            uint8_t length_bytes[2];
-            if (fread(pause_bytes, sizeof(pause_bytes), 1, tf) != 1 ||
-                fread(length_bytes, sizeof(length_bytes), 1, tf) != 1) {
-                fprintf(stderr, "Truncated TZX block\n");
-                fclose(tf);
-                return 0;
-            }
+static void tape_waveform_trim_consumed(TapeWaveform* waveform, size_t consumed_index) {
+    if (waveform->count > TAPE_WAVEFORM_WINDOW_PULSES &&
+        consumed_index > waveform->window_base) {
+        size_t consumed = consumed_index - waveform->window_base;
+        memmove(waveform->pulses,
+                waveform->pulses + consumed,
+                (waveform->count - consumed) * sizeof(TapePulse));
+        waveform->window_base += consumed;
+        waveform->count -= consumed;
+    }
+}
+
+static void tape_wav_stream_close(TapePlaybackState* state) {
+    if (!state) {
+        return;
+    }
+    if (state->wav_stream.file) {
+        fclose(state->wav_stream.file);
+    }
+    memset(&state->wav_stream, 0, sizeof(state->wav_stream));
+}
 
-            uint32_t pause_ms = (uint32_t)pause_bytes[0] | ((uint32_t)pause_bytes[1] << 8);
-            uint32_t block_length = (uint32_t)length_bytes[0] | ((uint32_t)length_bytes[1] << 8);
+static void tape_wav_stream_restart(TapePlaybackState* state) {
+    TapeWavStream* stream = &state->wav_stream;
+    stream->next_sample = 0;
+    stream->previous_level = 1;
+    stream->run_length = 0;
+    stream->done = (stream->total_samples == 0);
+    state->waveform.count = 0;
+    state->waveform.window_base = 0;
+    state->waveform.initial_level = 1;
+}
 
-            uint8_t* buffer = NULL;
-            if (block_length > 0u) {
-                buffer = (uint8_t*)malloc(block_length);
-                if (!buffer) {
-                    fprintf(stderr, "Out of memory while reading TZX block\n");
-                    fclose(tf);
-                    return 0;
-                }
-                if (fread(buffer, block_length, 1, tf) != 1) {
-                    fprintf(stderr, "Failed to read TZX block payload\n");
-                    free(buffer);
-                    fclose(tf);
-                    return 0;
-                }
+// Decodes the next fixed-size run of samples from the WAV data chunk into the
+// sliding pulse window. I/O errors simply end the tape.
+static void tape_wav_stream_decode_chunk(TapePlaybackState* state) {
+    TapeWavStream* stream = &state->wav_stream;
+    TapeWaveform* waveform = &state->waveform;
+    if (!stream->file || stream->done) {
+        return;
+    }
+
+    tape_waveform_trim_consumed(waveform, state->waveform_index);
+
+    static uint8_t buffer[TAPE_WAV_STREAM_CHUNK_BYTES];
+    size_t bytes_per_sample = (size_t)stream->bytes_per_sample;
+    uint64_t remaining = stream->total_samples - stream->next_sample;
+    size_t samples = sizeof(buffer) / bytes_per_sample;
+    if ((uint64_t)samples > remaining) {
+        samples = (size_t)remaining;
+    }
+    if (samples == 0) {
+        stream->done = 1;
+        return;
+    }
+
+    long position = stream->data_offset + (long)(stream->next_sample * (uint64_t)bytes_per_sample);
+    if (fseek(stream->file, position, SEEK_SET) != 0 ||
+        fread(buffer, samples * bytes_per_sample, 1, stream->file) != 1) {
+        stream->done = 1;
+        return;
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < samples; ++i) {
+        int32_t sample_value;
+        if (bytes_per_sample == 2) {
+            sample_value = (int16_t)((uint16_t)buffer[offset] | ((uint16_t)buffer[offset + 1] << 8));
+        } else {
+            sample_value = (int32_t)buffer[offset] - 128;
+        }
+        int level = (sample_value >= 0) ? 1 : 0;
+
+        if (stream->next_sample == 0) {
+            waveform->initial_level = level;
+            stream->previous_level = level;
+            stream->run_length = 1;
+        } else if (level == stream->previous_level) {
+            stream->run_length++;
+        } else {
+            uint64_t duration = (uint64_t)(stream->tstates_per_sample * (double)stream->run_length + 0.5);
+            if (duration == 0) {
+                duration = 1;
+            }
+            if (!tape_waveform_add_pulse(waveform, duration)) {
+                stream->done = 1;
+                return;
             }
+            stream->previous_level = level;
+            stream->run_length = 1;
+        }
 
-            if (buffer) {
-                if (!tape_image_add_block(image, buffer, block_length, pause_ms == 0xFFFFu ? 0u : pause_ms)) {
-                    fprintf(stderr, "Failed to store TZX block\n");
-                    free(buffer);
-                    fclose(tf);
-                    return 0;
-                }
-                free(buffer);
-            } else {
-                uint8_t empty = 0;
-                if (!tape_image_add_block(image, &empty, 0u, pause_ms == 0xFFFFu ? 0u : pause_ms)) {
-                    fprintf(stderr, "Failed to store empty TZX block\n");
-                    fclose(tf);
-                    return 0;
-                }
+        stream->next_sample++;
+        offset += bytes_per_sample;
+    }
+
+    if (stream->next_sample >= stream->total_samples) {
+        // The final run is dropped, matching the up-front decoder.
+        stream->done = 1;
+    }
+}
+
+// Makes sure the pulse at the absolute index is inside the window, expanding
+// further blocks as needed and trimming pulses the playback cursor has
+// already consumed. Returns 0 once the tape (or memory) is exhausted.
+static int tape_playback_has_pulse(TapePlaybackState* state, size_t abs_index) {
+    TapeWaveform* waveform = &state->waveform;
+    if (state->wav_stream.file) {
+        while (abs_index >= waveform->window_base + waveform->count &&
+               !state->wav_stream.done) {
+            tape_wav_stream_decode_chunk(state);
+        }
+        return abs_index >= waveform->window_base &&
+               abs_index < waveform->window_base + waveform->count;
+    }
+    if (!waveform->streaming) {
+        return abs_index < waveform->count;
+    }
+
+    while (abs_index >= waveform->window_base + waveform->count && !waveform->stream_done) {
+        if (waveform->stream_next_block >= state->image.count) {
+            waveform->stream_done = 1;
+            break;
+        }
+        tape_waveform_trim_consumed(waveform, state->waveform_index);
+        if (!tape_waveform_expand_block(waveform,
+                                        &state->image.blocks[waveform->stream_next_block],
+                                        &waveform->stream_pending_silence)) {
+            waveform->stream_done = 1;
+            break;
+        }
+        waveform->stream_next_block++;
+    }
+
+    return abs_index >= waveform->window_base &&
+           abs_index < waveform->window_base + waveform->count;
+}
+
+static uint64_t tape_playback_pulse_duration(TapePlaybackState* state, size_t abs_index) {
+    const TapeWaveform* waveform = &state->waveform;
+    return (uint64_t)waveform->pulses[abs_index - waveform->window_base].duration;
+}
+
+// Maps the file read-only so block payloads can reference it with no
+// per-block copies; falls back to a single whole-file read where mmap is
+// unavailable. The backing is released by tape_free_image.
+static int tape_image_attach_backing(TapeImage* image, const char* path) {
+    if (!image || !path) {
+        return 0;
+    }
+
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* mapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                close(fd);
+                image->backing = (uint8_t*)mapped;
+                image->backing_size = (size_t)st.st_size;
+                image->backing_is_mapped = 1;
+                return 1;
             }
-        } else if (block_id == 0x11) {
-            uint8_t header_bytes[16];
-            if (fread(header_bytes, sizeof(header_bytes), 1, tf) != 1) {
-                fprintf(stderr, "Truncated TZX turbo data block\n");
-                fclose(tf);
+        }
+        close(fd);
+    }
+#endif
+
+    FILE* tf = fopen(path, "rb");
+    if (!tf) {
+        return 0;
+    }
+    if (fseek(tf, 0, SEEK_END) != 0) {
+        fclose(tf);
+        return 0;
+    }
+    long file_size = ftell(tf);
+    if (file_size < 0 || fseek(tf, 0, SEEK_SET) != 0) {
+        fclose(tf);
+        return 0;
+    }
+
+    uint8_t* buffer = NULL;
+    if (file_size > 0) {
+        buffer = (uint8_t*)malloc((size_t)file_size);
+        if (!buffer) {
+            fclose(tf);
+            return 0;
+        }
+        if (fread(buffer, (size_t)file_size, 1, tf) != 1) {
+            free(buffer);
+            fclose(tf);
+            return 0;
+        }
+    }
+    fclose(tf);
+
+    image->backing = buffer;
+    image->backing_size = (size_t)file_size;
+    image->backing_is_mapped = 0;
+    return 1;
+}
+
+static uint16_t tape_read_le16(const uint8_t* bytes) {
+    return (uint16_t)((uint16_t)bytes[0] | ((uint16_t)bytes[1] << 8));
+}
+
+static uint32_t tape_read_le24(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16);
+}
+
+static int tape_load_tap(const char* path, TapeImage* image) {
+    if (!tape_image_attach_backing(image, path)) {
+        fprintf(stderr, "Failed to open TAP file '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    const uint8_t* data = image->backing;
+    size_t size = image->backing_size;
+    size_t offset = 0;
+    while (size - offset >= 2u) {
+        uint32_t block_length = tape_read_le16(data + offset);
+        offset += 2u;
+        if ((size_t)block_length > size - offset) {
+            fprintf(stderr, "Failed to read TAP block payload\n");
+            return 0;
+        }
+
+        if (!tape_image_add_block(image, data + offset, block_length, 1000u, 0)) {
+            fprintf(stderr, "Failed to store TAP block\n");
+            return 0;
+        }
+        offset += block_length;
+    }
+
+    if (tape_debug_logging) {
+        tape_log("Loaded TAP '%s' with %zu blocks\n", path, image->count);
+    }
+    return 1;
+}
+
+static int tape_load_tzx(const char* path, TapeImage* image) {
+    if (!tape_image_attach_backing(image, path)) {
+        fprintf(stderr, "Failed to open TZX file '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    const uint8_t* data = image->backing;
+    size_t size = image->backing_size;
+    if (size < 10u || memcmp(data, "ZXTape!\x1A", 8) != 0) {
+        fprintf(stderr, "File '%s' is not a valid TZX image\n", path);
+        return 0;
+    }
+
+    size_t offset = 10u;
+    while (offset < size) {
+        uint8_t block_id = data[offset++];
+        if (block_id == 0x10) {
+            if (size - offset < 4u) {
+                fprintf(stderr, "Truncated TZX block\n");
                 return 0;
             }
-            uint16_t pilot_pulse = (uint16_t)header_bytes[0] | ((uint16_t)header_bytes[1] << 8);
-            uint16_t sync1 = (uint16_t)header_bytes[2] | ((uint16_t)header_bytes[3] << 8);
-            uint16_t sync2 = (uint16_t)header_bytes[4] | ((uint16_t)header_bytes[5] << 8);
-            uint16_t bit0_first = (uint16_t)header_bytes[6] | ((uint16_t)header_bytes[7] << 8);
-            uint16_t bit0_second = (uint16_t)header_bytes[8] | ((uint16_t)header_bytes[9] << 8);
-            uint16_t bit1_first = (uint16_t)header_bytes[10] | ((uint16_t)header_bytes[11] << 8);
-            uint16_t bit1_second = (uint16_t)header_bytes[12] | ((uint16_t)header_bytes[13] << 8);
-            uint16_t pilot_count = (uint16_t)header_bytes[14] | ((uint16_t)header_bytes[15] << 8);
-            int used_bits = fgetc(tf);
-            if (used_bits == EOF) {
-                fprintf(stderr, "Truncated TZX turbo data block\n");
-                fclose(tf);
+            uint32_t pause_ms = tape_read_le16(data + offset);
+            uint32_t block_length = tape_read_le16(data + offset + 2u);
+            offset += 4u;
+            if ((size_t)block_length > size - offset) {
+                fprintf(stderr, "Failed to read TZX block payload\n");
                 return 0;
             }
-            uint8_t pause_bytes[2];
-            if (fread(pause_bytes, sizeof(pause_bytes), 1, tf) != 1) {
-                fprintf(stderr, "Truncated TZX turbo data block\n");
-                fclose(tf);
+
+            if (!tape_image_add_block(image, data + offset, block_length, pause_ms == 0xFFFFu ? 0u : pause_ms, 0)) {
+                fprintf(stderr, "Failed to store TZX block\n");
                 return 0;
             }
-            uint8_t length_bytes[3];
-            if (fread(length_bytes, sizeof(length_bytes), 1, tf) != 1) {
+            offset += block_length;
+        } else if (block_id == 0x11) {
+            if (size - offset < 22u) {
                 fprintf(stderr, "Truncated TZX turbo data block\n");
-                fclose(tf);
                 return 0;
             }
-            uint32_t pause_ms = (uint32_t)pause_bytes[0] | ((uint32_t)pause_bytes[1] << 8);
-            uint32_t block_length = (uint32_t)length_bytes[0] |
-                                    ((uint32_t)length_bytes[1] << 8) |
-                                    ((uint32_t)length_bytes[2] << 16);
-            uint8_t* buffer = NULL;
-            if (block_length > 0u) {
-                buffer = (uint8_t*)malloc(block_length);
-                if (!buffer) {
-                    fprintf(stderr, "Out of memory while reading TZX turbo block\n");
-                    fclose(tf);
-                    return 0;
-                }
-                if (fread(buffer, block_length, 1, tf) != 1) {
-                    fprintf(stderr, "Failed to read TZX turbo block payload\n");
-                    free(buffer);
-                    fclose(tf);
-                    return 0;
-                }
+            const uint8_t* header_bytes = data + offset;
+            uint16_t pilot_pulse = tape_read_le16(header_bytes);
+            uint16_t sync1 = tape_read_le16(header_bytes + 2);
+            uint16_t sync2 = tape_read_le16(header_bytes + 4);
+            uint16_t bit0_first = tape_read_le16(header_bytes + 6);
+            uint16_t bit0_second = tape_read_le16(header_bytes + 8);
+            uint16_t bit1_first = tape_read_le16(header_bytes + 10);
+            uint16_t bit1_second = tape_read_le16(header_bytes + 12);
+            uint16_t pilot_count = tape_read_le16(header_bytes + 14);
+            uint8_t used_bits = header_bytes[16];
+            uint32_t pause_ms = tape_read_le16(header_bytes + 17);
+            uint32_t block_length = tape_read_le24(header_bytes + 19);
+            offset += 22u;
+            if ((size_t)block_length > size - offset) {
+                fprintf(stderr, "Failed to read TZX turbo block payload\n");
+                return 0;
             }
+
             if (!tape_image_add_turbo_block(image,
-                                            buffer,
+                                            data + offset,
                                             block_length,
                                             pause_ms == 0xFFFFu ? 0u : pause_ms,
                                             pilot_pulse,
@@ -3283,178 +4398,120 @@ static int tape_load_tzx(const char* path, TapeImage* image) {
                                             bit0_second,
                                             bit1_first,
                                             bit1_second,
-                                            (uint8_t)(used_bits & 0xFF))) {
+                                            used_bits,
+                                            0)) {
                 fprintf(stderr, "Failed to store TZX turbo block\n");
-                free(buffer);
-                fclose(tf);
                 return 0;
             }
-            free(buffer);
+            offset += block_length;
         } else if (block_id == 0x12) {
-            uint8_t tone_bytes[4];
-            if (fread(tone_bytes, sizeof(tone_bytes), 1, tf) != 1) {
+            if (size - offset < 4u) {
                 fprintf(stderr, "Truncated TZX pure tone block\n");
-                fclose(tf);
                 return 0;
             }
-            uint16_t pulse_length = (uint16_t)tone_bytes[0] | ((uint16_t)tone_bytes[1] << 8);
-            uint16_t pulse_count = (uint16_t)tone_bytes[2] | ((uint16_t)tone_bytes[3] << 8);
+            uint16_t pulse_length = tape_read_le16(data + offset);
+            uint16_t pulse_count = tape_read_le16(data + offset + 2u);
+            offset += 4u;
             if (!tape_image_add_pure_tone_block(image, pulse_length, pulse_count, 0u)) {
                 fprintf(stderr, "Failed to store TZX pure tone block\n");
-                fclose(tf);
                 return 0;
             }
         } else if (block_id == 0x13) {
-            int pulse_count = fgetc(tf);
-            if (pulse_count == EOF) {
+            if (size - offset < 1u) {
                 fprintf(stderr, "Truncated TZX pulse sequence block\n");
-                fclose(tf);
                 return 0;
             }
-            if (pulse_count == 0) {
+            size_t count = data[offset++];
+            if (count == 0u) {
                 continue;
             }
-            size_t count = (size_t)(pulse_count & 0xFF);
+            if (size - offset < count * 2u) {
+                fprintf(stderr, "Truncated TZX pulse sequence block\n");
+                return 0;
+            }
+            // Pulse durations need widening to uint16_t, so this is the one
+            // block type that keeps the copy-and-transform path.
             uint16_t* durations = (uint16_t*)malloc(count * sizeof(uint16_t));
             if (!durations) {
                 fprintf(stderr, "Out of memory while reading pulse sequence\n");
-                fclose(tf);
                 return 0;
             }
             for (size_t i = 0; i < count; ++i) {
-                uint8_t duration_bytes[2];
-                if (fread(duration_bytes, sizeof(duration_bytes), 1, tf) != 1) {
-                    fprintf(stderr, "Truncated TZX pulse sequence block\n");
-                    free(durations);
-                    fclose(tf);
-                    return 0;
-                }
-                durations[i] = (uint16_t)duration_bytes[0] | ((uint16_t)duration_bytes[1] << 8);
+                durations[i] = tape_read_le16(data + offset + i * 2u);
             }
+            offset += count * 2u;
             if (!tape_image_add_pulse_sequence_block(image, durations, count, 0u)) {
                 fprintf(stderr, "Failed to store TZX pulse sequence block\n");
                 free(durations);
-                fclose(tf);
                 return 0;
             }
             free(durations);
         } else if (block_id == 0x14) {
-            uint8_t header_bytes[8];
-            if (fread(header_bytes, sizeof(header_bytes), 1, tf) != 1) {
-                fprintf(stderr, "Truncated TZX pure data block\n");
-                fclose(tf);
-                return 0;
-            }
-            uint16_t bit0_first = (uint16_t)header_bytes[0] | ((uint16_t)header_bytes[1] << 8);
-            uint16_t bit0_second = (uint16_t)header_bytes[2] | ((uint16_t)header_bytes[3] << 8);
-            uint16_t bit1_first = (uint16_t)header_bytes[4] | ((uint16_t)header_bytes[5] << 8);
-            uint16_t bit1_second = (uint16_t)header_bytes[6] | ((uint16_t)header_bytes[7] << 8);
-            int used_bits = fgetc(tf);
-            if (used_bits == EOF) {
-                fprintf(stderr, "Truncated TZX pure data block\n");
-                fclose(tf);
-                return 0;
-            }
-            uint8_t pause_bytes[2];
-            if (fread(pause_bytes, sizeof(pause_bytes), 1, tf) != 1) {
+            if (size - offset < 14u) {
                 fprintf(stderr, "Truncated TZX pure data block\n");
-                fclose(tf);
                 return 0;
             }
-            uint8_t length_bytes[3];
-            if (fread(length_bytes, sizeof(length_bytes), 1, tf) != 1) {
-                fprintf(stderr, "Truncated TZX pure data block\n");
-                fclose(tf);
+            const uint8_t* header_bytes = data + offset;
+            uint16_t bit0_first = tape_read_le16(header_bytes);
+            uint16_t bit0_second = tape_read_le16(header_bytes + 2);
+            uint16_t bit1_first = tape_read_le16(header_bytes + 4);
+            uint16_t bit1_second = tape_read_le16(header_bytes + 6);
+            uint8_t used_bits = header_bytes[8];
+            uint32_t pause_ms = tape_read_le16(header_bytes + 9);
+            uint32_t block_length = tape_read_le24(header_bytes + 11);
+            offset += 14u;
+            if ((size_t)block_length > size - offset) {
+                fprintf(stderr, "Failed to read TZX pure data block payload\n");
                 return 0;
             }
-            uint32_t pause_ms = (uint32_t)pause_bytes[0] | ((uint32_t)pause_bytes[1] << 8);
-            uint32_t block_length = (uint32_t)length_bytes[0] |
-                                    ((uint32_t)length_bytes[1] << 8) |
-                                    ((uint32_t)length_bytes[2] << 16);
-            uint8_t* buffer = NULL;
-            if (block_length > 0u) {
-                buffer = (uint8_t*)malloc(block_length);
-                if (!buffer) {
-                    fprintf(stderr, "Out of memory while reading TZX pure data block\n");
-                    fclose(tf);
-                    return 0;
-                }
-                if (fread(buffer, block_length, 1, tf) != 1) {
-                    fprintf(stderr, "Failed to read TZX pure data block payload\n");
-                    free(buffer);
-                    fclose(tf);
-                    return 0;
-                }
-            }
+
             if (!tape_image_add_pure_data_block(image,
-                                                buffer,
+                                                data + offset,
                                                 block_length,
                                                 pause_ms == 0xFFFFu ? 0u : pause_ms,
                                                 bit0_first,
                                                 bit0_second,
                                                 bit1_first,
                                                 bit1_second,
-                                                (uint8_t)(used_bits & 0xFF))) {
+                                                used_bits,
+                                                0)) {
                 fprintf(stderr, "Failed to store TZX pure data block\n");
-                free(buffer);
-                fclose(tf);
                 return 0;
             }
-            free(buffer);
+            offset += block_length;
         } else if (block_id == 0x15) {
-            uint8_t header_bytes[5];
-            if (fread(header_bytes, sizeof(header_bytes), 1, tf) != 1) {
+            if (size - offset < 8u) {
                 fprintf(stderr, "Truncated TZX direct recording block\n");
-                fclose(tf);
                 return 0;
             }
-            uint16_t sample_tstates = (uint16_t)header_bytes[0] | ((uint16_t)header_bytes[1] << 8);
-            uint16_t pause_ms = (uint16_t)header_bytes[2] | ((uint16_t)header_bytes[3] << 8);
+            const uint8_t* header_bytes = data + offset;
+            uint16_t sample_tstates = tape_read_le16(header_bytes);
+            uint16_t pause_ms = tape_read_le16(header_bytes + 2);
             uint8_t used_bits = header_bytes[4];
-            uint8_t length_bytes[3];
-            if (fread(length_bytes, sizeof(length_bytes), 1, tf) != 1) {
-                fprintf(stderr, "Truncated TZX direct recording block\n");
-                fclose(tf);
+            uint32_t sample_bytes = tape_read_le24(header_bytes + 5);
+            offset += 8u;
+            if ((size_t)sample_bytes > size - offset) {
+                fprintf(stderr, "Failed to read TZX direct recording block payload\n");
                 return 0;
             }
-            uint32_t sample_bytes = (uint32_t)length_bytes[0] |
-                                     ((uint32_t)length_bytes[1] << 8) |
-                                     ((uint32_t)length_bytes[2] << 16);
-            uint8_t* buffer = NULL;
-            if (sample_bytes > 0u) {
-                buffer = (uint8_t*)malloc(sample_bytes);
-                if (!buffer) {
-                    fprintf(stderr, "Out of memory while reading TZX direct recording block\n");
-                    fclose(tf);
-                    return 0;
-                }
-                if (fread(buffer, sample_bytes, 1, tf) != 1) {
-                    fprintf(stderr, "Failed to read TZX direct recording block payload\n");
-                    free(buffer);
-                    fclose(tf);
-                    return 0;
-                }
-            }
+
             if (!tape_image_add_direct_recording_block(image,
                                                        sample_tstates,
-                                                       buffer,
+                                                       data + offset,
                                                        sample_bytes,
                                                        used_bits,
-                                                       pause_ms == 0xFFFFu ? 0u : (uint32_t)pause_ms)) {
+                                                       pause_ms == 0xFFFFu ? 0u : (uint32_t)pause_ms,
+                                                       0)) {
                 fprintf(stderr, "Failed to store TZX direct recording block\n");
-                free(buffer);
-                fclose(tf);
                 return 0;
             }
-            free(buffer);
+            offset += sample_bytes;
         } else {
             fprintf(stderr, "Unsupported TZX block type 0x%02X in '%s'\n", block_id, path);
-            fclose(tf);
             return 0;
         }
     }
 
-    fclose(tf);
     return 1;
 }
 
@@ -4133,6 +5190,13 @@ static int snapshot_load_z80(const char* path, Z80* cpu) {
             gate_array_1ffd_state = 0u;
         }
 
+        // The memory blocks above went straight into ram_pages, so the 64K
+        // view is stale; invalidate the mappings before re-applying them or
+        // spectrum_map_page() writes that stale view back over a loaded bank.
+        for (int i = 0; i < 4; ++i) {
+            spectrum_pages[i].type = MEMORY_PAGE_NONE;
+            spectrum_pages[i].index = 0u;
+        }
         spectrum_apply_memory_configuration();
         spectrum_refresh_visible_ram();
     }
@@ -4165,105 +5229,444 @@ static int snapshot_load(const char* path, SnapshotFormat format, Z80* cpu) {
     return 0;
 }
 
-static int tape_create_blank_wav(const char* path, uint32_t sample_rate) {
-    if (!path) {
-        return 0;
-    }
-
-    if (sample_rate == 0u) {
-        sample_rate = 44100u;
+static uint8_t z80_model_to_hardware_mode(SpectrumModel model) {
+    switch (model) {
+        case SPECTRUM_MODEL_128K:
+            return 4u;
+        case SPECTRUM_MODEL_PLUS2A:
+            return 6u;
+        case SPECTRUM_MODEL_PLUS3:
+            return 7u;
+        case SPECTRUM_MODEL_48K:
+        default:
+            return 0u;
     }
+}
 
-    FILE* wf = fopen(path, "wb");
-    if (!wf) {
-        fprintf(stderr, "Failed to create WAV file '%s': %s\n", path, strerror(errno));
+// RLE compressor mirroring z80_decompress_block_buffer: runs of five or more
+// identical bytes (two or more for 0xED) become ED ED count value, and the
+// byte following a lone 0xED is stored raw so the decoder never misreads it
+// as an escape. Returns the compressed length, or 0 if dest overflows.
+static size_t z80_compress_block_buffer(const uint8_t* src,
+                                        size_t src_len,
+                                        uint8_t* dest,
+                                        size_t dest_cap) {
+    if (!src || !dest) {
         return 0;
     }
 
-    uint8_t header[44];
-    memset(header, 0, sizeof(header));
-    memcpy(header + 0, "RIFF", 4);
-    uint32_t chunk_size = 36u;
-    header[4] = (uint8_t)(chunk_size & 0xFFu);
-    header[5] = (uint8_t)((chunk_size >> 8) & 0xFFu);
-    header[6] = (uint8_t)((chunk_size >> 16) & 0xFFu);
-    header[7] = (uint8_t)((chunk_size >> 24) & 0xFFu);
-    memcpy(header + 8, "WAVE", 4);
-    memcpy(header + 12, "fmt ", 4);
-    header[16] = 16;
-    header[20] = 1;
-    header[22] = 1;
-    header[24] = (uint8_t)(sample_rate & 0xFFu);
-    header[25] = (uint8_t)((sample_rate >> 8) & 0xFFu);
-    header[26] = (uint8_t)((sample_rate >> 16) & 0xFFu);
-    header[27] = (uint8_t)((sample_rate >> 24) & 0xFFu);
-
-    uint32_t byte_rate = sample_rate * sizeof(int16_t);
-    header[28] = (uint8_t)(byte_rate & 0xFFu);
-    header[29] = (uint8_t)((byte_rate >> 8) & 0xFFu);
-    header[30] = (uint8_t)((byte_rate >> 16) & 0xFFu);
-    header[31] = (uint8_t)((byte_rate >> 24) & 0xFFu);
-    header[32] = (uint8_t)(sizeof(int16_t));
-    header[34] = 16;
-    memcpy(header + 36, "data", 4);
+    size_t src_index = 0;
+    size_t dest_index = 0;
+    while (src_index < src_len) {
+        uint8_t value = src[src_index];
+        size_t run = 1;
+        while (src_index + run < src_len && src[src_index + run] == value && run < 255u) {
+            run++;
+        }
 
-    if (fwrite(header, sizeof(header), 1, wf) != 1) {
-        fprintf(stderr, "Failed to write WAV header to '%s'\n", path);
-        fclose(wf);
-        return 0;
-    }
+        if (run >= 5u || (value == 0xEDu && run >= 2u)) {
+            if (dest_index + 4u > dest_cap) {
+                return 0;
+            }
+            dest[dest_index++] = 0xEDu;
+            dest[dest_index++] = 0xEDu;
+            dest[dest_index++] = (uint8_t)run;
+            dest[dest_index++] = value;
+            src_index += run;
+            continue;
+        }
 
-    if (fclose(wf) != 0) {
-        fprintf(stderr, "Failed to finalize WAV file '%s': %s\n", path, strerror(errno));
-        return 0;
+        if (dest_index >= dest_cap) {
+            return 0;
+        }
+        dest[dest_index++] = value;
+        src_index++;
+        if (value == 0xEDu && src_index < src_len) {
+            if (dest_index >= dest_cap) {
+                return 0;
+            }
+            dest[dest_index++] = src[src_index++];
+        }
     }
 
-    return 1;
+    return dest_index;
 }
 
-static int tape_load_wav(const char* path, TapePlaybackState* state) {
-    if (!path || !state) {
-        return 0;
-    }
-
-    FILE* wf = fopen(path, "rb");
-    if (!wf) {
-        if (errno != ENOENT) {
-            fprintf(stderr, "Failed to open WAV file '%s': %s\n", path, strerror(errno));
-            return 0;
-        }
+// Writes one 16K page as a v2/3 memory block, falling back to the
+// uncompressed 0xFFFF form when compression does not shrink the page.
+static int z80_write_memory_block(FILE* sf, const uint8_t* page, uint8_t page_id) {
+    static uint8_t compressed[0x4000u * 2u];
+    size_t compressed_len = z80_compress_block_buffer(page, 0x4000u, compressed, sizeof(compressed));
 
-        uint32_t sample_rate = (audio_sample_rate > 0) ? (uint32_t)audio_sample_rate : 44100u;
-        if (!tape_create_blank_wav(path, sample_rate)) {
+    uint8_t block_header[3];
+    if (compressed_len > 0u && compressed_len < 0x4000u) {
+        block_header[0] = (uint8_t)(compressed_len & 0xFFu);
+        block_header[1] = (uint8_t)((compressed_len >> 8) & 0xFFu);
+        block_header[2] = page_id;
+        if (fwrite(block_header, sizeof(block_header), 1, sf) != 1 ||
+            fwrite(compressed, compressed_len, 1, sf) != 1) {
             return 0;
         }
-        printf("Created empty WAV tape %s\n", path);
-        tape_free_image(&state->image);
-        tape_waveform_reset(&state->waveform);
-        state->waveform.sample_rate = sample_rate;
-        state->format = TAPE_FORMAT_WAV;
-        tape_wav_shared_position_tstates = 0;
         return 1;
     }
 
-    uint8_t riff_header[12];
-    if (fread(riff_header, sizeof(riff_header), 1, wf) != 1) {
-        fprintf(stderr, "Failed to read WAV header from '%s'\n", path);
-        fclose(wf);
+    block_header[0] = 0xFFu;
+    block_header[1] = 0xFFu;
+    block_header[2] = page_id;
+    if (fwrite(block_header, sizeof(block_header), 1, sf) != 1 ||
+        fwrite(page, 0x4000u, 1, sf) != 1) {
         return 0;
     }
+    return 1;
+}
 
-    if (memcmp(riff_header, "RIFF", 4) != 0 || memcmp(riff_header + 8, "WAVE", 4) != 0) {
-        fprintf(stderr, "File '%s' is not a valid WAV image\n", path);
-        fclose(wf);
+static int snapshot_save_z80(const char* path, const Z80* cpu) {
+    if (!path || !cpu) {
         return 0;
     }
 
-    uint16_t audio_format = 0;
+    FILE* sf = fopen(path, "wb");
+    if (!sf) {
+        fprintf(stderr, "Failed to open snapshot output '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    uint8_t header[30];
+    memset(header, 0, sizeof(header));
+    header[0] = cpu->reg_A;
+    header[1] = cpu->reg_F;
+    header[2] = cpu->reg_C;
+    header[3] = cpu->reg_B;
+    header[4] = cpu->reg_L;
+    header[5] = cpu->reg_H;
+    // header[6..7]: PC stays zero; the v3 extended header carries it.
+    header[8] = (uint8_t)(cpu->reg_SP & 0xFFu);
+    header[9] = (uint8_t)((cpu->reg_SP >> 8) & 0xFFu);
+    header[10] = cpu->reg_I;
+    header[11] = (uint8_t)(cpu->reg_R & 0x7Fu);
+    header[12] = (uint8_t)(((cpu->reg_R & 0x80u) ? 0x01u : 0x00u) |
+                           ((border_color_idx & 0x07u) << 1));
+    header[13] = cpu->reg_E;
+    header[14] = cpu->reg_D;
+    header[15] = cpu->alt_reg_C;
+    header[16] = cpu->alt_reg_B;
+    header[17] = cpu->alt_reg_E;
+    header[18] = cpu->alt_reg_D;
+    header[19] = cpu->alt_reg_L;
+    header[20] = cpu->alt_reg_H;
+    header[21] = cpu->alt_reg_A;
+    header[22] = cpu->alt_reg_F;
+    header[23] = (uint8_t)(cpu->reg_IY & 0xFFu);
+    header[24] = (uint8_t)((cpu->reg_IY >> 8) & 0xFFu);
+    header[25] = (uint8_t)(cpu->reg_IX & 0xFFu);
+    header[26] = (uint8_t)((cpu->reg_IX >> 8) & 0xFFu);
+    header[27] = cpu->iff1 ? 1u : 0u;
+    header[28] = cpu->iff2 ? 1u : 0u;
+    header[29] = (uint8_t)(cpu->interruptMode & 0x03u);
+
+    int is_128k_family = (spectrum_model != SPECTRUM_MODEL_48K);
+
+    uint8_t ext_header[54];
+    memset(ext_header, 0, sizeof(ext_header));
+    ext_header[0] = (uint8_t)(cpu->reg_PC & 0xFFu);
+    ext_header[1] = (uint8_t)((cpu->reg_PC >> 8) & 0xFFu);
+    ext_header[2] = z80_model_to_hardware_mode(spectrum_model);
+    ext_header[3] = is_128k_family ? gate_array_7ffd_state : 0u;
+    if (spectrum_model == SPECTRUM_MODEL_PLUS2A || spectrum_model == SPECTRUM_MODEL_PLUS3) {
+        ext_header[4] = gate_array_1ffd_state;
+    }
+
+    uint8_t ext_len_bytes[2] = {(uint8_t)sizeof(ext_header), 0u};
+
+    int success = fwrite(header, sizeof(header), 1, sf) == 1 &&
+                  fwrite(ext_len_bytes, sizeof(ext_len_bytes), 1, sf) == 1 &&
+                  fwrite(ext_header, sizeof(ext_header), 1, sf) == 1;
+
+    if (success) {
+        if (is_128k_family) {
+            // Page ids match snapshot_load_z80()'s direct bank mapping.
+            for (uint8_t bank = 0; bank < 8 && success; ++bank) {
+                success = z80_write_memory_block(sf, ram_pages[bank], bank);
+            }
+        } else {
+            success = z80_write_memory_block(sf, ram_pages[5], 8u) &&
+                      z80_write_memory_block(sf, ram_pages[2], 4u) &&
+                      z80_write_memory_block(sf, ram_pages[7], 5u);
+        }
+    }
+
+    if (fclose(sf) != 0) {
+        success = 0;
+    }
+    if (!success) {
+        fprintf(stderr, "Failed to write Z80 snapshot '%s'\n", path);
+        remove(path);
+        return 0;
+    }
+
+    fprintf(stderr,
+            "Saved Z80 snapshot '%s': model %s PC=%04X frame=%" PRIu64 "\n",
+            path,
+            spectrum_model_to_string(spectrum_model),
+            (unsigned)cpu->reg_PC,
+            emulated_frame_count);
+    return 1;
+}
+
+static void snapshot_save_request(const Z80* cpu) {
+    char path[PATH_MAX];
+    if (snapshot_save_path && *snapshot_save_path) {
+        snprintf(path, sizeof(path), "%s", snapshot_save_path);
+    } else {
+        snprintf(path, sizeof(path), "snapshot-frame-%" PRIu64 ".z80", emulated_frame_count);
+    }
+    (void)snapshot_save_z80(path, cpu);
+}
+
+// --- Rewind ring ---
+// A ring of machine states captured every few frames for instant step-back.
+// RAM is stored as refcounted 16K page snapshots: a bank that did not change
+// since the previous capture (tracked by rewind_bank_dirty, fed from the RAM
+// write shadow) shares the previous capture's page, so an idle machine costs
+// a few hundred bytes per capture instead of a 128K memcpy.
+#define REWIND_CAPTURE_INTERVAL_FRAMES 25u
+#define REWIND_RING_CAPACITY 1200u
+
+typedef struct {
+    int refcount;
+    uint8_t data[0x4000];
+} RewindPage;
+
+typedef struct {
+    int valid;
+    Z80 cpu;
+    SpectrumModel model;
+    uint64_t frame;
+    uint8_t port_7ffd;
+    uint8_t port_1ffd;
+    uint8_t border;
+    uint8_t ay_regs[16];
+    uint8_t ay_selected;
+    RewindPage* pages[8];
+} RewindState;
+
+static RewindState rewind_ring[REWIND_RING_CAPACITY];
+static size_t rewind_head = 0; // next slot to capture into
+static size_t rewind_count = 0;
+
+static void rewind_state_release(RewindState* state) {
+    if (!state->valid) {
+        return;
+    }
+    for (int bank = 0; bank < 8; ++bank) {
+        RewindPage* page = state->pages[bank];
+        if (page && --page->refcount == 0) {
+            free(page);
+        }
+        state->pages[bank] = NULL;
+    }
+    state->valid = 0;
+}
+
+static void rewind_reset(void) {
+    for (size_t i = 0; i < REWIND_RING_CAPACITY; ++i) {
+        rewind_state_release(&rewind_ring[i]);
+    }
+    rewind_head = 0;
+    rewind_count = 0;
+    memset(rewind_bank_dirty, 1, sizeof(rewind_bank_dirty));
+}
+
+static int rewind_capture(const Z80* cpu) {
+    RewindState* prev = NULL;
+    if (rewind_count > 0) {
+        prev = &rewind_ring[(rewind_head + REWIND_RING_CAPACITY - 1u) % REWIND_RING_CAPACITY];
+    }
+
+    RewindState* slot = &rewind_ring[rewind_head];
+    rewind_state_release(slot);
+
+    slot->cpu = *cpu;
+    slot->model = spectrum_model;
+    slot->frame = emulated_frame_count;
+    slot->port_7ffd = gate_array_7ffd_state;
+    slot->port_1ffd = gate_array_1ffd_state;
+    slot->border = (uint8_t)(border_color_idx & 0x07u);
+    memcpy(slot->ay_regs, ay_registers, sizeof(slot->ay_regs));
+    slot->ay_selected = ay_selected_register;
+
+    for (int bank = 0; bank < 8; ++bank) {
+        if (!rewind_bank_dirty[bank] && prev && prev->valid &&
+            prev->model == spectrum_model && prev->pages[bank]) {
+            slot->pages[bank] = prev->pages[bank];
+            slot->pages[bank]->refcount++;
+            continue;
+        }
+        RewindPage* page = (RewindPage*)malloc(sizeof(RewindPage));
+        if (!page) {
+            slot->valid = 1; // so release frees what was captured so far
+            rewind_state_release(slot);
+            return 0;
+        }
+        page->refcount = 1;
+        memcpy(page->data, ram_pages[bank], 0x4000u);
+        slot->pages[bank] = page;
+    }
+
+    memset(rewind_bank_dirty, 0, sizeof(rewind_bank_dirty));
+    slot->valid = 1;
+    rewind_head = (rewind_head + 1u) % REWIND_RING_CAPACITY;
+    if (rewind_count < REWIND_RING_CAPACITY) {
+        rewind_count++;
+    }
+    return 1;
+}
+
+static int rewind_step_back(Z80* cpu) {
+    if (rewind_count == 0) {
+        printf("Rewind buffer empty\n");
+        return 0;
+    }
+
+    rewind_head = (rewind_head + REWIND_RING_CAPACITY - 1u) % REWIND_RING_CAPACITY;
+    rewind_count--;
+    RewindState* state = &rewind_ring[rewind_head];
+
+    spectrum_configure_model(state->model);
+    for (int bank = 0; bank < 8; ++bank) {
+        memcpy(ram_pages[bank], state->pages[bank]->data, 0x4000u);
+    }
+
+    gate_array_7ffd_state = state->port_7ffd;
+    paging_disabled = (gate_array_7ffd_state & 0x20u) ? 1 : 0;
+    current_paged_bank = (uint8_t)(gate_array_7ffd_state & 0x07u);
+    if (state->model == SPECTRUM_MODEL_PLUS2A || state->model == SPECTRUM_MODEL_PLUS3) {
+        gate_array_1ffd_state = state->port_1ffd;
+    } else {
+        gate_array_1ffd_state = 0u;
+    }
+    border_color_idx = state->border;
+    for (uint8_t reg = 0; reg < 16u; ++reg) {
+        ay_write_register(reg, state->ay_regs[reg]);
+    }
+    ay_selected_register = state->ay_selected;
+
+    for (int i = 0; i < 4; ++i) {
+        spectrum_pages[i].type = MEMORY_PAGE_NONE;
+        spectrum_pages[i].index = 0u;
+    }
+    spectrum_apply_memory_configuration();
+    spectrum_refresh_visible_ram();
+
+    *cpu = state->cpu;
+
+    printf("Rewound to frame %" PRIu64 "\n", state->frame);
+    rewind_state_release(state);
+    memset(rewind_bank_dirty, 1, sizeof(rewind_bank_dirty));
+    scheduler_invalidate();
+    return 1;
+}
+
+static int tape_create_blank_wav(const char* path, uint32_t sample_rate) {
+    if (!path) {
+        return 0;
+    }
+
+    if (sample_rate == 0u) {
+        sample_rate = 44100u;
+    }
+
+    FILE* wf = fopen(path, "wb");
+    if (!wf) {
+        fprintf(stderr, "Failed to create WAV file '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    uint8_t header[44];
+    memset(header, 0, sizeof(header));
+    memcpy(header + 0, "RIFF", 4);
+    uint32_t chunk_size = 36u;
+    header[4] = (uint8_t)(chunk_size & 0xFFu);
+    header[5] = (uint8_t)((chunk_size >> 8) & 0xFFu);
+    header[6] = (uint8_t)((chunk_size >> 16) & 0xFFu);
+    header[7] = (uint8_t)((chunk_size >> 24) & 0xFFu);
+    memcpy(header + 8, "WAVE", 4);
+    memcpy(header + 12, "fmt ", 4);
+    header[16] = 16;
+    header[20] = 1;
+    header[22] = 1;
+    header[24] = (uint8_t)(sample_rate & 0xFFu);
+    header[25] = (uint8_t)((sample_rate >> 8) & 0xFFu);
+    header[26] = (uint8_t)((sample_rate >> 16) & 0xFFu);
+    header[27] = (uint8_t)((sample_rate >> 24) & 0xFFu);
+
+    uint32_t byte_rate = sample_rate * sizeof(int16_t);
+    header[28] = (uint8_t)(byte_rate & 0xFFu);
+    header[29] = (uint8_t)((byte_rate >> 8) & 0xFFu);
+    header[30] = (uint8_t)((byte_rate >> 16) & 0xFFu);
+    header[31] = (uint8_t)((byte_rate >> 24) & 0xFFu);
+    header[32] = (uint8_t)(sizeof(int16_t));
+    header[34] = 16;
+    memcpy(header + 36, "data", 4);
+
+    if (fwrite(header, sizeof(header), 1, wf) != 1) {
+        fprintf(stderr, "Failed to write WAV header to '%s'\n", path);
+        fclose(wf);
+        return 0;
+    }
+
+    if (fclose(wf) != 0) {
+        fprintf(stderr, "Failed to finalize WAV file '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    return 1;
+}
+
+static int tape_load_wav(const char* path, TapePlaybackState* state) {
+    if (!path || !state) {
+        return 0;
+    }
+
+    FILE* wf = fopen(path, "rb");
+    if (!wf) {
+        if (errno != ENOENT) {
+            fprintf(stderr, "Failed to open WAV file '%s': %s\n", path, strerror(errno));
+            return 0;
+        }
+
+        uint32_t sample_rate = (audio_sample_rate > 0) ? (uint32_t)audio_sample_rate : 44100u;
+        if (!tape_create_blank_wav(path, sample_rate)) {
+            return 0;
+        }
+        printf("Created empty WAV tape %s\n", path);
+        tape_free_image(&state->image);
+        tape_waveform_reset(&state->waveform);
+        tape_wav_stream_close(state);
+        state->waveform.sample_rate = sample_rate;
+        state->format = TAPE_FORMAT_WAV;
+        tape_wav_shared_position_tstates = 0;
+        return 1;
+    }
+
+    uint8_t riff_header[12];
+    if (fread(riff_header, sizeof(riff_header), 1, wf) != 1) {
+        fprintf(stderr, "Failed to read WAV header from '%s'\n", path);
+        fclose(wf);
+        return 0;
+    }
+
+    if (memcmp(riff_header, "RIFF", 4) != 0 || memcmp(riff_header + 8, "WAVE", 4) != 0) {
+        fprintf(stderr, "File '%s' is not a valid WAV image\n", path);
+        fclose(wf);
+        return 0;
+    }
+
+    uint16_t audio_format = 0;
     uint16_t num_channels = 0;
     uint32_t sample_rate = 0;
     uint16_t bits_per_sample = 0;
-    uint8_t* data_buffer = NULL;
+    long data_offset = -1;
     uint32_t data_size = 0;
     int have_fmt = 0;
     int have_data = 0;
@@ -4283,21 +5686,18 @@ static int tape_load_wav(const char* path, TapePlaybackState* state) {
             if (chunk_size < 16) {
                 fprintf(stderr, "Invalid WAV fmt chunk in '%s'\n", path);
                 fclose(wf);
-                free(data_buffer);
                 return 0;
             }
             uint8_t* fmt_data = (uint8_t*)malloc(chunk_size);
             if (!fmt_data) {
                 fprintf(stderr, "Out of memory while reading WAV fmt chunk\n");
                 fclose(wf);
-                free(data_buffer);
                 return 0;
             }
             if (fread(fmt_data, chunk_size, 1, wf) != 1) {
                 fprintf(stderr, "Failed to read WAV fmt chunk\n");
                 free(fmt_data);
                 fclose(wf);
-                free(data_buffer);
                 return 0;
             }
             audio_format = (uint16_t)fmt_data[0] | ((uint16_t)fmt_data[1] << 8);
@@ -4310,36 +5710,21 @@ static int tape_load_wav(const char* path, TapePlaybackState* state) {
             free(fmt_data);
             have_fmt = 1;
         } else if (memcmp(chunk_header, "data", 4) == 0) {
-            if (chunk_size == 0) {
-                free(data_buffer);
-                data_buffer = NULL;
-                data_size = 0;
-                have_data = 1;
-            } else {
-                uint8_t* buffer = (uint8_t*)malloc(chunk_size);
-                if (!buffer) {
-                    fprintf(stderr, "Out of memory while reading WAV data chunk\n");
-                    fclose(wf);
-                    free(data_buffer);
-                    return 0;
-                }
-                if (fread(buffer, chunk_size, 1, wf) != 1) {
-                    fprintf(stderr, "Failed to read WAV data chunk\n");
-                    free(buffer);
-                    fclose(wf);
-                    free(data_buffer);
-                    return 0;
-                }
-                free(data_buffer);
-                data_buffer = buffer;
-                data_size = chunk_size;
-                have_data = 1;
+            // The sample data stays on disk; remember where it lives so the
+            // streaming decoder can read it in windows.
+            data_offset = ftell(wf);
+            data_size = chunk_size;
+            have_data = 1;
+            if (data_offset < 0 ||
+                (chunk_size > 0 && fseek(wf, (long)chunk_size, SEEK_CUR) != 0)) {
+                fprintf(stderr, "Failed to skip WAV chunk in '%s'\n", path);
+                fclose(wf);
+                return 0;
             }
         } else {
             if (fseek(wf, chunk_size, SEEK_CUR) != 0) {
                 fprintf(stderr, "Failed to skip WAV chunk in '%s'\n", path);
                 fclose(wf);
-                free(data_buffer);
                 return 0;
             }
         }
@@ -4348,7 +5733,6 @@ static int tape_load_wav(const char* path, TapePlaybackState* state) {
             if (fseek(wf, 1, SEEK_CUR) != 0) {
                 fprintf(stderr, "Failed to align WAV chunk in '%s'\n", path);
                 fclose(wf);
-                free(data_buffer);
                 return 0;
             }
         }
@@ -4358,107 +5742,82 @@ static int tape_load_wav(const char* path, TapePlaybackState* state) {
         }
     }
 
-    fclose(wf);
-
     if (!have_fmt || !have_data) {
         fprintf(stderr, "WAV file '%s' is missing required chunks\n", path);
-        free(data_buffer);
+        fclose(wf);
         return 0;
     }
 
     if (audio_format != 1) {
         fprintf(stderr, "WAV file '%s' is not PCM encoded\n", path);
-        free(data_buffer);
+        fclose(wf);
         return 0;
     }
 
     if (num_channels != 1) {
         fprintf(stderr, "WAV file '%s' must be mono for tape loading\n", path);
-        free(data_buffer);
+        fclose(wf);
         return 0;
     }
 
     if (bits_per_sample != 8 && bits_per_sample != 16) {
         fprintf(stderr, "Unsupported WAV bit depth (%u) in '%s'\n", (unsigned)bits_per_sample, path);
-        free(data_buffer);
+        fclose(wf);
         return 0;
     }
 
     if (sample_rate == 0) {
         fprintf(stderr, "Invalid WAV sample rate in '%s'\n", path);
-        free(data_buffer);
+        fclose(wf);
         return 0;
     }
 
     int bytes_per_sample = bits_per_sample / 8;
     if (bytes_per_sample <= 0) {
-        free(data_buffer);
+        fclose(wf);
         return 0;
     }
 
     if (data_size % (uint32_t)bytes_per_sample != 0u) {
         fprintf(stderr, "Corrupt WAV data chunk in '%s'\n", path);
-        free(data_buffer);
+        fclose(wf);
         return 0;
     }
 
-    size_t total_samples = data_size / (size_t)bytes_per_sample;
+    uint64_t total_samples = data_size / (uint32_t)bytes_per_sample;
 
     tape_free_image(&state->image);
     tape_waveform_reset(&state->waveform);
+    tape_wav_stream_close(state);
     state->waveform.sample_rate = sample_rate;
     state->format = TAPE_FORMAT_WAV;
 
     if (total_samples == 0) {
-        free(data_buffer);
+        fclose(wf);
+        if (state == &tape_playback) {
+            tape_wav_shared_position_tstates = 0;
+        }
         return 1;
     }
 
-    size_t offset = 0;
-    int32_t first_value = 0;
-    if (bits_per_sample == 16) {
-        first_value = (int16_t)((uint16_t)data_buffer[offset] | ((uint16_t)data_buffer[offset + 1] << 8));
-    } else {
-        first_value = (int32_t)data_buffer[offset] - 128;
-    }
-    int previous_level = (first_value >= 0) ? 1 : 0;
-    state->waveform.initial_level = previous_level;
-    size_t run_length = 1;
-    offset += (size_t)bytes_per_sample;
-
-    double tstates_per_sample = CPU_CLOCK_HZ / (double)sample_rate;
-
-    for (size_t sample_index = 1; sample_index < total_samples; ++sample_index) {
-        int32_t sample_value = 0;
-        if (bits_per_sample == 16) {
-            sample_value = (int16_t)((uint16_t)data_buffer[offset] | ((uint16_t)data_buffer[offset + 1] << 8));
-        } else {
-            sample_value = (int32_t)data_buffer[offset] - 128;
-        }
-        int level = (sample_value >= 0) ? 1 : 0;
+    state->wav_stream.file = wf;
+    state->wav_stream.data_offset = data_offset;
+    state->wav_stream.data_size = data_size;
+    state->wav_stream.bytes_per_sample = bytes_per_sample;
+    state->wav_stream.total_samples = total_samples;
+    state->wav_stream.tstates_per_sample = CPU_CLOCK_HZ / (double)sample_rate;
+    tape_wav_stream_restart(state);
+    (void)tape_playback_has_pulse(state, 0);
 
-        if (level == previous_level) {
-            run_length++;
-        } else {
-            uint64_t duration = (uint64_t)(tstates_per_sample * (double)run_length + 0.5);
-            if (duration == 0 && run_length > 0) {
-                duration = 1;
-            }
-            if (!tape_waveform_add_pulse(&state->waveform, duration)) {
-                fprintf(stderr, "Out of memory while decoding WAV tape\n");
-                free(data_buffer);
-                tape_waveform_reset(&state->waveform);
-                state->format = TAPE_FORMAT_NONE;
-                return 0;
-            }
-            previous_level = level;
-            run_length = 1;
+    if (tape_preload_waveform) {
+        // Opt-in full decode: nothing is trimmed while the cursor sits at
+        // zero, so draining the stream leaves the whole tape resident.
+        while (!state->wav_stream.done) {
+            tape_wav_stream_decode_chunk(state);
         }
-
-        offset += (size_t)bytes_per_sample;
+        tape_wav_stream_close(state);
     }
 
-    free(data_buffer);
     if (state == &tape_playback) {
         tape_wav_shared_position_tstates = 0;
     }
@@ -4605,6 +5964,12 @@ static void ay_compute_pan_gains(double pan, double* left_gain, double* right_ga
     *right_gain = sin(angle);
 }
 
+static void ay_refresh_pan_gains(void) {
+    for (int ch = 0; ch < 3; ++ch) {
+        ay_compute_pan_gains(ay_channel_pan[ch], &ay_pan_gain_left[ch], &ay_pan_gain_right[ch]);
+    }
+}
+
 static double ay_highpass(double input, double* last_input, double* last_output) {
     if (!last_input || !last_output) {
         return 0.0;
@@ -4722,9 +6087,14 @@ static void ay_step_generators(double elapsed_cycles) {
             continue;
         }
         double counter = ay_state.tone_counter[ch] - elapsed_cycles;
-        while (counter <= 0.0) {
-            counter += period;
-            ay_state.tone_output[ch] ^= 1;
+        if (counter <= 0.0) {
+            // Arithmetic catch-up: a single division tells us how many edges
+            // elapsed; only the parity matters for the square-wave output.
+            uint64_t toggles = (uint64_t)(-counter / period) + 1u;
+            counter += (double)toggles * period;
+            if (toggles & 1u) {
+                ay_state.tone_output[ch] ^= 1;
+            }
         }
         ay_state.tone_counter[ch] = counter;
     }
@@ -4788,6 +6158,7 @@ static void ay_reset_state_internal(void) {
     ay_refresh_noise_period();
     ay_refresh_envelope_period();
     ay_restart_envelope();
+    ay_refresh_pan_gains();
     ay_hp_last_input_left = 0.0;
     ay_hp_last_output_left = 0.0;
     ay_hp_last_input_right = 0.0;
@@ -4814,38 +6185,76 @@ static void ay_set_sample_rate(int sample_rate) {
     ay_cycles_per_sample = AY_CLOCK_HZ / (double)sample_rate;
 }
 
-static void ay_mix_sample(double elapsed_cycles, double* left_out, double* right_out) {
-    if (!left_out || !right_out) {
+static void ay_render_block(double cycles_per_sample, int num_frames, double* left_out, double* right_out) {
+    if (!left_out || !right_out || num_frames <= 0) {
         return;
     }
-    if (ay_cycles_per_sample <= 0.0) {
-        *left_out = 0.0;
-        *right_out = 0.0;
+    if (ay_cycles_per_sample <= 0.0 || cycles_per_sample <= 0.0) {
+        for (int i = 0; i < num_frames; ++i) {
+            left_out[i] = 0.0;
+            right_out[i] = 0.0;
+        }
         return;
     }
 
-    double step_cycles = (elapsed_cycles > 0.0) ? elapsed_cycles : ay_cycles_per_sample;
-    ay_step_generators(step_cycles);
+    int frame = 0;
+    while (frame < num_frames) {
+        ay_step_generators(cycles_per_sample);
 
-    double left = 0.0;
-    double right = 0.0;
-    for (int ch = 0; ch < 3; ++ch) {
-        double level = ay_channel_level(ch);
-        if (level <= 0.0) {
-            continue;
+        // The mix is constant until the next generator edge, so work out how
+        // many whole samples fit before any counter can reach zero and render
+        // them as one run. Only the high-pass filter ticks per sample; the
+        // generators are advanced over the run with a single subtraction.
+        double min_counter = ay_state.tone_counter[0];
+        for (int ch = 1; ch < 3; ++ch) {
+            if (ay_state.tone_counter[ch] < min_counter) {
+                min_counter = ay_state.tone_counter[ch];
+            }
+        }
+        if (ay_state.noise_counter < min_counter) {
+            min_counter = ay_state.noise_counter;
+        }
+        if (ay_state.envelope_counter < min_counter) {
+            min_counter = ay_state.envelope_counter;
         }
-        double pan_left = 0.0;
-        double pan_right = 0.0;
-        ay_compute_pan_gains(ay_channel_pan[ch], &pan_left, &pan_right);
-        left += level * pan_left;
-        right += level * pan_right;
-    }
 
-    double filtered_left = ay_highpass(left, &ay_hp_last_input_left, &ay_hp_last_output_left);
-    double filtered_right = ay_highpass(right, &ay_hp_last_input_right, &ay_hp_last_output_right);
+        int extra = (int)(min_counter / cycles_per_sample);
+        while (extra > 0 && (double)extra * cycles_per_sample >= min_counter) {
+            --extra;
+        }
+        int remaining = num_frames - frame - 1;
+        if (extra < 0) {
+            extra = 0;
+        } else if (extra > remaining) {
+            extra = remaining;
+        }
+
+        double left = 0.0;
+        double right = 0.0;
+        for (int ch = 0; ch < 3; ++ch) {
+            double level = ay_channel_level(ch);
+            if (level <= 0.0) {
+                continue;
+            }
+            left += level * ay_pan_gain_left[ch];
+            right += level * ay_pan_gain_right[ch];
+        }
+
+        for (int i = 0; i <= extra; ++i) {
+            left_out[frame] = ay_highpass(left, &ay_hp_last_input_left, &ay_hp_last_output_left) * ay_global_gain;
+            right_out[frame] = ay_highpass(right, &ay_hp_last_input_right, &ay_hp_last_output_right) * ay_global_gain;
+            ++frame;
+        }
 
-    *left_out = filtered_left * ay_global_gain;
-    *right_out = filtered_right * ay_global_gain;
+        if (extra > 0) {
+            double advance = (double)extra * cycles_per_sample;
+            for (int ch = 0; ch < 3; ++ch) {
+                ay_state.tone_counter[ch] -= advance;
+            }
+            ay_state.noise_counter -= advance;
+            ay_state.envelope_counter -= advance;
+        }
+    }
 }
 
 static void ay_write_register(uint8_t reg, uint8_t value) {
@@ -4923,6 +6332,7 @@ static int ay_parse_pan_spec(const char* spec) {
     for (size_t i = 0; i < 3; ++i) {
         ay_channel_pan[i] = parsed[i];
     }
+    ay_refresh_pan_gains();
     return 1;
 }
 
@@ -4940,6 +6350,13 @@ static void tape_reset_playback(TapePlaybackState* state) {
     state->pause_end_tstate = 0;
     state->playing = 0;
     state->waveform_index = 0;
+    if (state->waveform.streaming) {
+        tape_waveform_stream_restart(&state->waveform);
+        (void)tape_playback_has_pulse(state, 0);
+    } else if (state->wav_stream.file) {
+        tape_wav_stream_restart(state);
+        (void)tape_playback_has_pulse(state, 0);
+    }
     state->paused_transition_remaining = 0;
     state->paused_pause_remaining = 0;
     state->position_tstates = 0;
@@ -5020,7 +6437,7 @@ static void tape_start_playback(TapePlaybackState* state, uint64_t start_time) {
         speaker_tape_playback_level = tape_ear_state;
         speaker_update_output(start_time, 1);
         state->playing = 1;
-        state->next_transition_tstate = start_time + (uint64_t)state->waveform.pulses[0].duration;
+        state->next_transition_tstate = start_time + tape_playback_pulse_duration(state, 0);
         state->paused_transition_remaining = 0;
         state->paused_pause_remaining = 0;
         return;
@@ -5066,7 +6483,7 @@ static int tape_resume_playback(TapePlaybackState* state, uint64_t current_t_sta
     int use_waveform = (state->format == TAPE_FORMAT_WAV) ||
                        (state->use_waveform_playback && state->waveform.count > 0);
     if (use_waveform) {
-        if (state->waveform.count == 0 || state->waveform_index >= state->waveform.count) {
+        if (state->waveform.count == 0 || !tape_playback_has_pulse(state, state->waveform_index)) {
             return 0;
         }
         uint64_t delay = state->paused_transition_remaining;
@@ -5118,16 +6535,80 @@ static void tape_rewind_playback(TapePlaybackState* state) {
     tape_reset_playback(state);
 }
 
-static void tape_playback_accumulate_elapsed(TapePlaybackState* state, uint64_t stop_t_state) {
-    if (!state) {
-        return;
+// O(1) seek straight to a block using the load-time index: no replay from
+// zero. Works for both playback models — phase-based playback restarts at the
+// block's pilot tone, waveform playback repositions the pulse cursor (and for
+// streamed tapes restarts the window at the block's first pulse). A stopped
+// deck stays stopped; PLAY resumes from the target block.
+static int tape_jump_to_block(TapePlaybackState* state, size_t block_index, uint64_t current_t_state) {
+    if (!state || block_index >= state->image.count) {
+        return 0;
     }
-
-    if (stop_t_state < state->position_start_tstate) {
-        stop_t_state = state->position_start_tstate;
+    if (state->format == TAPE_FORMAT_WAV) {
+        return 0; // raw samples: no block structure to seek by
+    }
+    if (!state->block_index || block_index >= state->block_index_count) {
+        return 0;
     }
 
-    if (stop_t_state > state->position_start_tstate) {
+    int was_playing = state->playing;
+    const TapeBlockIndexEntry* entry = &state->block_index[block_index];
+    int use_waveform = state->use_waveform_playback &&
+                       (state->waveform.count > 0 || state->waveform.streaming);
+    if (use_waveform) {
+        TapeWaveform* waveform = &state->waveform;
+        if (waveform->streaming) {
+            // Restart the sliding window at the block's first pulse; the
+            // stream expands forward from there on demand.
+            waveform->count = 0;
+            waveform->window_base = (size_t)entry->start_pulse;
+            waveform->stream_next_block = block_index;
+            waveform->stream_pending_silence = 0;
+            waveform->stream_done = 0;
+        }
+        state->waveform_index = (size_t)entry->start_pulse;
+        if (!tape_playback_has_pulse(state, state->waveform_index)) {
+            return 0;
+        }
+        state->current_block = block_index;
+        // Every pulse toggles the level, so parity of the pulse index gives
+        // the level at the block boundary.
+        state->level = (waveform->initial_level ^ (int)(entry->start_pulse & 1u)) ? 1 : 0;
+        tape_ear_state = state->level;
+        speaker_tape_playback_level = tape_ear_state;
+        speaker_update_output(current_t_state, 1);
+        state->playing = 1;
+        state->last_transition_tstate = current_t_state;
+        state->next_transition_tstate =
+            current_t_state + tape_playback_pulse_duration(state, state->waveform_index);
+        state->paused_transition_remaining = 0;
+        state->paused_pause_remaining = 0;
+    } else {
+        if (!tape_begin_block(state, block_index, current_t_state)) {
+            return 0;
+        }
+    }
+
+    // The elapsed-position counter now reports the seek target instead of
+    // only tracking forward progress.
+    state->position_tstates = entry->start_tstates;
+    state->position_start_tstate = current_t_state;
+    if (!was_playing) {
+        tape_pause_playback(state, current_t_state);
+    }
+    return 1;
+}
+
+static void tape_playback_accumulate_elapsed(TapePlaybackState* state, uint64_t stop_t_state) {
+    if (!state) {
+        return;
+    }
+
+    if (stop_t_state < state->position_start_tstate) {
+        stop_t_state = state->position_start_tstate;
+    }
+
+    if (stop_t_state > state->position_start_tstate) {
         state->position_tstates += stop_t_state - state->position_start_tstate;
     }
 
@@ -5797,54 +7278,83 @@ static void tape_manager_toggle(void) {
     }
 }
 
-static int tape_manager_refresh_browser(const char* directory) {
-    char target[PATH_MAX];
-    if (directory && *directory) {
-        size_t length = strlen(directory);
-        if (length >= sizeof(target)) {
-            length = sizeof(target) - 1u;
-        }
-        if (length >= sizeof(target)) {
-            length = sizeof(target) - 1u;
-        }
-        memcpy(target, directory, length);
-        target[length] = '\0';
-    } else {
-        if (!TAPE_GETCWD(target, sizeof(target))) {
-            target[0] = '.';
-            target[1] = '\0';
-        }
-    }
-
-    tape_manager_browser_normalize_separators(target);
-    if (target[0] == '\0') {
-        target[0] = '.';
-        target[1] = '\0';
-    }
+// Directory listings are scanned on a worker thread and cached keyed by
+// path + directory mtime. The software library can live on slow network
+// storage with thousands of entries, and the old browser re-read and
+// re-sorted the whole directory on the emulation thread every time it was
+// opened, stalling the frame loop. Now reopening an unchanged directory
+// reuses the cached sorted entry array instantly, a changed or unseen one
+// streams partial results into the overlay while the worker scans, and the
+// emulation loop never touches the filesystem beyond a single stat() of the
+// directory itself.
+#define TAPE_BROWSER_CACHE_SLOTS 8
 
-    DIR* dir = opendir(target);
+typedef struct {
+    char path[PATH_MAX];
+    time_t mtime;
+    TapeBrowserEntry* entries; // lazily malloc'd, MAX_ENTRIES capacity
+    int count;
+    int complete; // scan finished and entries are sorted
+    int cancel;   // abandon the in-flight scan of this slot
+    uint64_t last_used;
+} TapeBrowserCacheSlot;
+
+static TapeBrowserCacheSlot tape_browser_cache[TAPE_BROWSER_CACHE_SLOTS];
+static uint64_t tape_browser_cache_clock = 0;
+static unsigned tape_browser_scan_count = 0; // directories actually scanned
+
+static SDL_Thread* tape_browser_scan_thread = NULL;
+static SDL_mutex* tape_browser_scan_lock = NULL;
+static SDL_cond* tape_browser_scan_wake = NULL;
+static SDL_cond* tape_browser_scan_idle = NULL;
+static TapeBrowserCacheSlot* tape_browser_scan_pending = NULL;
+static TapeBrowserCacheSlot* tape_browser_scan_active = NULL;
+static int tape_browser_scan_shutdown = 0;
+
+// What the UI array currently reflects, so the poll step only copies when
+// the worker has produced something new.
+static int tape_browser_published_count = -1;
+static int tape_browser_published_complete = -1;
+
+static void tape_browser_scan_slot_lock(void) {
+    if (tape_browser_scan_lock) {
+        SDL_LockMutex(tape_browser_scan_lock);
+    }
+}
+
+static void tape_browser_scan_slot_unlock(void) {
+    if (tape_browser_scan_lock) {
+        SDL_UnlockMutex(tape_browser_scan_lock);
+    }
+}
+
+// Reads one directory into a cache slot. Runs on the worker thread, or
+// inline on the caller when no worker is available; entries are appended
+// one at a time under the lock so the UI can publish partial results, and
+// the final sort only happens once the listing is complete.
+static void tape_browser_scan_slot(TapeBrowserCacheSlot* slot) {
+    DIR* dir = opendir(slot->path);
     if (!dir) {
-        fprintf(stderr, "Failed to open directory '%s': %s\n", target, strerror(errno));
-        return 0;
+        fprintf(stderr, "Failed to open directory '%s': %s\n", slot->path, strerror(errno));
+        tape_browser_scan_slot_lock();
+        slot->count = 0;
+        slot->complete = 1;
+        tape_browser_scan_slot_unlock();
+        return;
     }
 
-    TapeBrowserEntry entries[TAPE_MANAGER_BROWSER_MAX_ENTRIES];
-    int entry_count = 0;
-
     struct dirent* dent = NULL;
+    int cancelled = 0;
     while ((dent = readdir(dir)) != NULL) {
-        if (strcmp(dent->d_name, ".") == 0) {
-            continue;
-        }
-        if (strcmp(dent->d_name, "..") == 0 && !tape_manager_browser_can_go_up(target)) {
+        if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0) {
             continue;
         }
-        if (entry_count >= TAPE_MANAGER_BROWSER_MAX_ENTRIES) {
+        if (slot->count >= TAPE_MANAGER_BROWSER_MAX_ENTRIES) {
             break;
         }
 
         char full_path[PATH_MAX];
-        if (!tape_manager_browser_join_path(target, dent->d_name, full_path, sizeof(full_path))) {
+        if (!tape_manager_browser_join_path(slot->path, dent->d_name, full_path, sizeof(full_path))) {
             continue;
         }
 
@@ -5869,27 +7379,215 @@ static int tape_manager_refresh_browser(const char* directory) {
             }
         }
 
-        TapeBrowserEntry* slot = &entries[entry_count++];
-        memset(slot, 0, sizeof(*slot));
+        tape_browser_scan_slot_lock();
+        if (slot->cancel) {
+            tape_browser_scan_slot_unlock();
+            cancelled = 1;
+            break;
+        }
+        TapeBrowserEntry* entry = &slot->entries[slot->count];
+        memset(entry, 0, sizeof(*entry));
         size_t name_length = strlen(dent->d_name);
-        if (name_length >= sizeof(slot->name)) {
-            name_length = sizeof(slot->name) - 1u;
+        if (name_length >= sizeof(entry->name)) {
+            name_length = sizeof(entry->name) - 1u;
         }
-        memcpy(slot->name, dent->d_name, name_length);
-        slot->name[name_length] = '\0';
-        slot->is_dir = is_dir ? 1 : 0;
-        slot->is_up = 0;
+        memcpy(entry->name, dent->d_name, name_length);
+        entry->name[name_length] = '\0';
+        entry->is_dir = is_dir ? 1 : 0;
+        entry->is_up = 0;
+        slot->count++;
+        tape_browser_scan_slot_unlock();
     }
 
     closedir(dir);
 
-    qsort(entries, entry_count, sizeof(TapeBrowserEntry), tape_browser_entry_compare);
+    tape_browser_scan_slot_lock();
+    if (cancelled || slot->cancel) {
+        slot->count = 0;
+        slot->cancel = 0;
+    } else {
+        qsort(slot->entries, (size_t)slot->count, sizeof(TapeBrowserEntry), tape_browser_entry_compare);
+        slot->complete = 1;
+        tape_browser_scan_count++;
+    }
+    tape_browser_scan_slot_unlock();
+}
+
+static int tape_browser_scan_worker(void* data) {
+    (void)data;
+    SDL_LockMutex(tape_browser_scan_lock);
+    for (;;) {
+        while (!tape_browser_scan_pending && !tape_browser_scan_shutdown) {
+            SDL_CondWait(tape_browser_scan_wake, tape_browser_scan_lock);
+        }
+        if (tape_browser_scan_shutdown && !tape_browser_scan_pending) {
+            break;
+        }
+        TapeBrowserCacheSlot* slot = tape_browser_scan_pending;
+        tape_browser_scan_pending = NULL;
+        tape_browser_scan_active = slot;
+        SDL_UnlockMutex(tape_browser_scan_lock);
 
-    strncpy(tape_manager_browser_path, target, sizeof(tape_manager_browser_path) - 1u);
-    tape_manager_browser_path[sizeof(tape_manager_browser_path) - 1u] = '\0';
+        tape_browser_scan_slot(slot);
 
-    tape_manager_browser_entry_count = 0;
+        SDL_LockMutex(tape_browser_scan_lock);
+        tape_browser_scan_active = NULL;
+        if (!tape_browser_scan_pending) {
+            SDL_CondBroadcast(tape_browser_scan_idle);
+        }
+    }
+    SDL_UnlockMutex(tape_browser_scan_lock);
+    return 0;
+}
+
+static int tape_browser_scan_start(void) {
+    if (tape_browser_scan_thread) {
+        return 1;
+    }
+    if (!tape_browser_scan_lock) {
+        tape_browser_scan_lock = SDL_CreateMutex();
+    }
+    if (!tape_browser_scan_wake) {
+        tape_browser_scan_wake = SDL_CreateCond();
+    }
+    if (!tape_browser_scan_idle) {
+        tape_browser_scan_idle = SDL_CreateCond();
+    }
+    if (!tape_browser_scan_lock || !tape_browser_scan_wake || !tape_browser_scan_idle) {
+        fprintf(stderr, "Warning: browser scan thread unavailable (%s); scanning synchronously\n", SDL_GetError());
+        return 0;
+    }
+    tape_browser_scan_shutdown = 0;
+    tape_browser_scan_thread = SDL_CreateThread(tape_browser_scan_worker, "tape-browser", NULL);
+    if (!tape_browser_scan_thread) {
+        fprintf(stderr, "Warning: browser scan thread unavailable (%s); scanning synchronously\n", SDL_GetError());
+        return 0;
+    }
+    return 1;
+}
+
+static void tape_browser_scan_drain(void) {
+    if (!tape_browser_scan_thread) {
+        return;
+    }
+    SDL_LockMutex(tape_browser_scan_lock);
+    while (tape_browser_scan_pending || tape_browser_scan_active) {
+        SDL_CondWait(tape_browser_scan_idle, tape_browser_scan_lock);
+    }
+    SDL_UnlockMutex(tape_browser_scan_lock);
+}
+
+static void tape_browser_scan_stop(void) {
+    if (tape_browser_scan_thread) {
+        SDL_LockMutex(tape_browser_scan_lock);
+        tape_browser_scan_shutdown = 1;
+        if (tape_browser_scan_active) {
+            tape_browser_scan_active->cancel = 1;
+        }
+        SDL_CondBroadcast(tape_browser_scan_wake);
+        SDL_UnlockMutex(tape_browser_scan_lock);
+        SDL_WaitThread(tape_browser_scan_thread, NULL);
+        tape_browser_scan_thread = NULL;
+    }
+    for (int i = 0; i < TAPE_BROWSER_CACHE_SLOTS; ++i) {
+        free(tape_browser_cache[i].entries);
+        memset(&tape_browser_cache[i], 0, sizeof(tape_browser_cache[i]));
+    }
+}
+
+// Finds or claims the cache slot for a directory. Returns NULL on allocation
+// failure; *needs_scan is set when the slot has no usable listing (new
+// directory, or its mtime no longer matches the cached one).
+static TapeBrowserCacheSlot* tape_browser_cache_acquire(const char* path, time_t mtime, int* needs_scan) {
+    tape_browser_scan_slot_lock();
+    TapeBrowserCacheSlot* slot = NULL;
+    for (int i = 0; i < TAPE_BROWSER_CACHE_SLOTS; ++i) {
+        if (tape_browser_cache[i].entries && strcmp(tape_browser_cache[i].path, path) == 0) {
+            slot = &tape_browser_cache[i];
+            break;
+        }
+    }
+
+    if (!slot) {
+        // Reuse an empty slot or evict the least recently used one, never
+        // the slot the worker is currently filling.
+        for (int i = 0; i < TAPE_BROWSER_CACHE_SLOTS; ++i) {
+            TapeBrowserCacheSlot* candidate = &tape_browser_cache[i];
+            if (candidate == tape_browser_scan_active || candidate == tape_browser_scan_pending) {
+                continue;
+            }
+            if (!candidate->entries) {
+                slot = candidate;
+                break;
+            }
+            if (!slot || candidate->last_used < slot->last_used) {
+                slot = candidate;
+            }
+        }
+        if (slot && !slot->entries) {
+            slot->entries = (TapeBrowserEntry*)malloc(TAPE_MANAGER_BROWSER_MAX_ENTRIES * sizeof(TapeBrowserEntry));
+            if (!slot->entries) {
+                tape_browser_scan_slot_unlock();
+                return NULL;
+            }
+        }
+        if (!slot) {
+            tape_browser_scan_slot_unlock();
+            return NULL;
+        }
+        strncpy(slot->path, path, sizeof(slot->path) - 1u);
+        slot->path[sizeof(slot->path) - 1u] = '\0';
+        slot->mtime = mtime;
+        slot->count = 0;
+        slot->complete = 0;
+        *needs_scan = 1;
+    } else if (slot->mtime != mtime || (!slot->complete && slot != tape_browser_scan_active && slot != tape_browser_scan_pending)) {
+        // The directory changed underneath the cache (or a previous scan was
+        // abandoned): restart it.
+        if (slot == tape_browser_scan_active) {
+            slot->cancel = 1;
+        }
+        slot->mtime = mtime;
+        slot->count = 0;
+        slot->complete = 0;
+        *needs_scan = 1;
+    } else {
+        *needs_scan = 0;
+    }
+
+    slot->last_used = ++tape_browser_cache_clock;
+    tape_browser_scan_slot_unlock();
+    return slot;
+}
+
+static TapeBrowserCacheSlot* tape_browser_cache_find(const char* path) {
+    for (int i = 0; i < TAPE_BROWSER_CACHE_SLOTS; ++i) {
+        if (tape_browser_cache[i].entries && strcmp(tape_browser_cache[i].path, path) == 0) {
+            return &tape_browser_cache[i];
+        }
+    }
+    return NULL;
+}
+
+// Copies whatever the scanner has produced for the current directory into
+// the UI entry array. Called from the emulation thread each frame while the
+// browser is open; it only takes the lock long enough to memcpy the slice
+// that changed since the last publish.
+static void tape_manager_browser_poll(void) {
+    TapeBrowserCacheSlot* slot = tape_browser_cache_find(tape_manager_browser_path);
+    if (!slot) {
+        return;
+    }
+
+    tape_browser_scan_slot_lock();
+    int count = slot->count;
+    int complete = slot->complete;
+    if (count == tape_browser_published_count && complete == tape_browser_published_complete) {
+        tape_browser_scan_slot_unlock();
+        return;
+    }
 
+    tape_manager_browser_entry_count = 0;
     if (tape_manager_browser_can_go_up(tape_manager_browser_path)) {
         TapeBrowserEntry* up = &tape_manager_browser_entries[tape_manager_browser_entry_count++];
         memset(up, 0, sizeof(*up));
@@ -5897,16 +7595,79 @@ static int tape_manager_refresh_browser(const char* directory) {
         up->is_up = 1;
         (void)snprintf(up->name, sizeof(up->name), "..");
     }
-
-    for (int i = 0; i < entry_count && tape_manager_browser_entry_count < TAPE_MANAGER_BROWSER_MAX_ENTRIES; ++i) {
-        tape_manager_browser_entries[tape_manager_browser_entry_count] = entries[i];
+    for (int i = 0; i < count && tape_manager_browser_entry_count < TAPE_MANAGER_BROWSER_MAX_ENTRIES; ++i) {
+        tape_manager_browser_entries[tape_manager_browser_entry_count] = slot->entries[i];
         tape_manager_browser_entry_count++;
     }
+    tape_browser_scan_slot_unlock();
+
+    tape_browser_published_count = count;
+    tape_browser_published_complete = complete;
+    tape_manager_browser_clamp_selection();
+
+    if (tape_manager_mode == TAPE_MANAGER_MODE_FILE_BROWSER && complete) {
+        if (tape_manager_browser_entry_count > 0) {
+            tape_manager_set_status("SELECT FILE AND PRESS RETURN");
+        } else {
+            tape_manager_set_status("NO TAPES FOUND IN DIRECTORY");
+        }
+    }
+}
+
+static int tape_manager_refresh_browser(const char* directory) {
+    char target[PATH_MAX];
+    if (directory && *directory) {
+        size_t length = strlen(directory);
+        if (length >= sizeof(target)) {
+            length = sizeof(target) - 1u;
+        }
+        memcpy(target, directory, length);
+        target[length] = '\0';
+    } else {
+        if (!TAPE_GETCWD(target, sizeof(target))) {
+            target[0] = '.';
+            target[1] = '\0';
+        }
+    }
+
+    tape_manager_browser_normalize_separators(target);
+    if (target[0] == '\0') {
+        target[0] = '.';
+        target[1] = '\0';
+    }
+
+    STAT_STRUCT st;
+    if (STAT_FUNC(target, &st) != 0 || !STAT_ISDIR(st.st_mode)) {
+        fprintf(stderr, "Failed to open directory '%s': %s\n", target, strerror(errno));
+        return 0;
+    }
+
+    int needs_scan = 0;
+    TapeBrowserCacheSlot* slot = tape_browser_cache_acquire(target, st.st_mtime, &needs_scan);
+    if (!slot) {
+        return 0;
+    }
+
+    strncpy(tape_manager_browser_path, target, sizeof(tape_manager_browser_path) - 1u);
+    tape_manager_browser_path[sizeof(tape_manager_browser_path) - 1u] = '\0';
 
     tape_manager_browser_selection = 0;
     tape_manager_browser_scroll = 0;
-    tape_manager_browser_clamp_selection();
+    tape_browser_published_count = -1;
+    tape_browser_published_complete = -1;
+
+    if (needs_scan) {
+        if (tape_browser_scan_start()) {
+            tape_browser_scan_slot_lock();
+            tape_browser_scan_pending = slot;
+            SDL_CondSignal(tape_browser_scan_wake);
+            tape_browser_scan_slot_unlock();
+        } else {
+            tape_browser_scan_slot(slot);
+        }
+    }
 
+    tape_manager_browser_poll();
     return 1;
 }
 
@@ -5937,7 +7698,9 @@ static void tape_manager_begin_browser(void) {
     }
 
     tape_manager_mode = TAPE_MANAGER_MODE_FILE_BROWSER;
-    if (tape_manager_browser_entry_count > 0) {
+    if (!tape_browser_published_complete) {
+        tape_manager_set_status("SCANNING DIRECTORY...");
+    } else if (tape_manager_browser_entry_count > 0) {
         tape_manager_set_status("SELECT FILE AND PRESS RETURN");
     } else {
         tape_manager_set_status("NO TAPES FOUND IN DIRECTORY");
@@ -5960,7 +7723,9 @@ static void tape_manager_browser_go_parent(void) {
         tape_manager_set_status("FAILED TO OPEN PARENT");
         return;
     }
-    if (tape_manager_browser_entry_count > 0) {
+    if (!tape_browser_published_complete) {
+        tape_manager_set_status("SCANNING DIRECTORY...");
+    } else if (tape_manager_browser_entry_count > 0) {
         tape_manager_set_status("SELECT FILE AND PRESS RETURN");
     } else {
         tape_manager_set_status("NO TAPES FOUND IN DIRECTORY");
@@ -5992,7 +7757,9 @@ static void tape_manager_browser_activate_selection(void) {
             tape_manager_set_status("FAILED TO OPEN DIRECTORY");
             return;
         }
-        if (tape_manager_browser_entry_count > 0) {
+        if (!tape_browser_published_complete) {
+            tape_manager_set_status("SCANNING DIRECTORY...");
+        } else if (tape_manager_browser_entry_count > 0) {
             tape_manager_set_status("SELECT FILE AND PRESS RETURN");
         } else {
             tape_manager_set_status("NO TAPES FOUND IN DIRECTORY");
@@ -6044,6 +7811,8 @@ static void tape_manager_eject_tape(void) {
     tape_recorder_stop_session(total_t_states, 1);
     tape_free_image(&tape_playback.image);
     tape_waveform_reset(&tape_playback.waveform);
+    tape_free_block_index(&tape_playback);
+    tape_wav_stream_close(&tape_playback);
     tape_playback.format = TAPE_FORMAT_NONE;
     tape_playback.use_waveform_playback = 0;
     tape_playback.playing = 0;
@@ -6191,13 +7960,17 @@ static int tape_manager_load_path(const char* path) {
             tape_manager_set_status("FAILED TO LOAD TAPE IMAGE");
             return 0;
         }
-        if (!tape_generate_waveform_from_image(&new_state.image, &new_state.waveform)) {
+        int waveform_ready = tape_preload_waveform
+                                 ? tape_generate_waveform_from_image(&new_state.image, &new_state.waveform)
+                                 : tape_waveform_stream_init(&new_state.image, &new_state.waveform);
+        if (!waveform_ready) {
             tape_free_image(&new_state.image);
             tape_waveform_reset(&new_state.waveform);
             tape_manager_set_status("FAILED TO PREPARE TAPE AUDIO");
             return 0;
         }
         new_state.use_waveform_playback = 1;
+        (void)tape_build_block_index(&new_state);
     }
 
     tape_reset_playback(&new_state);
@@ -6206,6 +7979,8 @@ static int tape_manager_load_path(const char* path) {
     tape_recorder_stop_session(total_t_states, 1);
     tape_free_image(&tape_playback.image);
     tape_waveform_reset(&tape_playback.waveform);
+    tape_free_block_index(&tape_playback);
+    tape_wav_stream_close(&tape_playback);
 
     tape_playback = new_state;
     tape_input_format = format;
@@ -6254,6 +8029,35 @@ static int tape_manager_load_path(const char* path) {
     return 1;
 }
 
+static void tape_manager_jump_block(int direction) {
+    if (tape_playback.format == TAPE_FORMAT_NONE || tape_playback.image.count == 0) {
+        tape_manager_set_status("NO TAPE LOADED");
+        return;
+    }
+    if (tape_playback.format == TAPE_FORMAT_WAV || tape_playback.block_index_count == 0) {
+        tape_manager_set_status("TAPE HAS NO BLOCK INDEX");
+        return;
+    }
+
+    size_t current = tape_playback.current_block;
+    size_t target;
+    if (direction < 0) {
+        target = (current > 0) ? current - 1u : 0u;
+    } else {
+        target = current + 1u;
+        if (target >= tape_playback.image.count) {
+            tape_manager_set_status("ALREADY AT LAST BLOCK");
+            return;
+        }
+    }
+
+    if (tape_jump_to_block(&tape_playback, target, total_t_states)) {
+        tape_manager_set_status("JUMPED TO BLOCK %zu/%zu", target + 1u, tape_playback.image.count);
+    } else {
+        tape_manager_set_status("BLOCK JUMP FAILED");
+    }
+}
+
 static int tape_manager_handle_event(const SDL_Event* event) {
     if (!event) {
         return 0;
@@ -6302,6 +8106,7 @@ static int tape_manager_handle_event(const SDL_Event* event) {
     }
 
     if (tape_manager_mode == TAPE_MANAGER_MODE_FILE_BROWSER) {
+        tape_manager_browser_poll();
         switch (key) {
             case SDLK_ESCAPE:
                 tape_manager_show_menu();
@@ -6368,6 +8173,12 @@ static int tape_manager_handle_event(const SDL_Event* event) {
             tape_deck_rewind(total_t_states);
             tape_manager_set_status("REWIND COMMAND SENT");
             return 1;
+        case SDLK_LEFT:
+            tape_manager_jump_block(-1);
+            return 1;
+        case SDLK_RIGHT:
+            tape_manager_jump_block(1);
+            return 1;
         case SDLK_r:
             tape_deck_record(total_t_states, (mods & KMOD_SHIFT) ? 1 : 0);
             if (tape_recorder.recording) {
@@ -6412,6 +8223,10 @@ static void tape_render_manager(void) {
         return;
     }
 
+    if (tape_manager_mode == TAPE_MANAGER_MODE_FILE_BROWSER) {
+        tape_manager_browser_poll();
+    }
+
     int scale = 2;
 
 layout_retry:
@@ -6576,7 +8391,7 @@ layout_retry:
     int shortcuts_width = 0;
     if (tape_manager_mode == TAPE_MANAGER_MODE_MENU) {
         shortcuts_lines[shortcuts_line_count] =
-            "SHORTCUTS: P PLAY  S STOP  W REWIND  R RECORD";
+            "SHORTCUTS: P PLAY  S STOP  W REWIND  R RECORD  ARROWS JUMP BLOCK";
         shortcuts_line_widths[shortcuts_line_count] =
             tape_overlay_text_width(shortcuts_lines[shortcuts_line_count], scale, spacing);
         if (shortcuts_line_widths[shortcuts_line_count] > shortcuts_width) {
@@ -7053,7 +8868,7 @@ static void tape_update(uint64_t current_t_state) {
     int use_waveform = (state->format == TAPE_FORMAT_WAV) ||
                        (state->use_waveform_playback && state->waveform.count > 0);
     if (use_waveform) {
-        while (state->playing && state->waveform_index < state->waveform.count &&
+        while (state->playing && tape_playback_has_pulse(state, state->waveform_index) &&
                current_t_state >= state->next_transition_tstate) {
             uint64_t transition_time = state->next_transition_tstate;
             if (transition_time < state->last_transition_tstate) {
@@ -7065,8 +8880,8 @@ static void tape_update(uint64_t current_t_state) {
             speaker_update_output(transition_time, 1);
             state->waveform_index++;
             state->last_transition_tstate = transition_time;
-            if (state->waveform_index < state->waveform.count) {
-                uint64_t duration = (uint64_t)state->waveform.pulses[state->waveform_index].duration;
+            if (tape_playback_has_pulse(state, state->waveform_index)) {
+                uint64_t duration = tape_playback_pulse_duration(state, state->waveform_index);
                 state->next_transition_tstate = transition_time + duration;
             } else {
                 state->playing = 0;
@@ -7251,19 +9066,15 @@ static void tape_update(uint64_t current_t_state) {
 }
 
 static void tape_recorder_reset_pulses(void) {
-    if (tape_recorder.pulses) {
-        free(tape_recorder.pulses);
-        tape_recorder.pulses = NULL;
-    }
+    tape_arena_release(&tape_recorder.pulse_arena);
+    tape_recorder.pulses = NULL;
     tape_recorder.pulse_count = 0;
     tape_recorder.pulse_capacity = 0;
 }
 
 static void tape_recorder_reset_audio(void) {
-    if (tape_recorder.audio_samples) {
-        free(tape_recorder.audio_samples);
-        tape_recorder.audio_samples = NULL;
-    }
+    tape_arena_release(&tape_recorder.audio_arena);
+    tape_recorder.audio_samples = NULL;
     tape_recorder.audio_sample_count = 0;
     tape_recorder.audio_sample_capacity = 0;
 }
@@ -7682,7 +9493,165 @@ static int tape_recorder_prepare_wav_session(uint64_t head_tstates) {
     return 1;
 }
 
+// --- Asynchronous tape encoder ---
+// Pulse decoding and WAV sample synthesis used to run on the emulation thread
+// inside tape_recorder_finalize_block(), so every completed SAVE block caused
+// a frame hitch proportional to its size. Finalised blocks are now handed to a
+// worker thread as jobs that own their pulse arena outright; the emulation
+// side only appends timestamped pulses. The worker performs the TAP decode,
+// audio synthesis and file writes, and session boundaries (start, stop,
+// shutdown) drain the queue so the recorded image and output file are always
+// complete before they are reset or re-read.
+typedef struct TapeEncodeJob {
+    struct TapeEncodeJob* next;
+    TapePulse* pulses;
+    size_t pulse_count;
+    TapeArena pulse_arena; // ownership transferred from the recorder
+    uint32_t pause_ms;
+    uint64_t idle_cycles;
+    int block_start_level;
+    int last_level;
+    int write_output; // flush the session to disk after this job
+} TapeEncodeJob;
+
+static SDL_Thread* tape_encoder_thread = NULL;
+static SDL_mutex* tape_encoder_lock = NULL;
+static SDL_cond* tape_encoder_wake = NULL;
+static SDL_cond* tape_encoder_idle = NULL;
+static TapeEncodeJob* tape_encoder_queue_head = NULL;
+static TapeEncodeJob* tape_encoder_queue_tail = NULL;
+static int tape_encoder_busy = 0;
+static int tape_encoder_shutdown_requested = 0;
+
+static void tape_encoder_process_job(TapeEncodeJob* job) {
+    if (job->pulse_count > 0) {
+        if (tape_recorder.output_format == TAPE_OUTPUT_TAP && job->pulse_count >= 100) {
+            TapeBlock block = {0};
+            if (!tape_decode_pulses_to_block(job->pulses, job->pulse_count, job->pause_ms, &block)) {
+                fprintf(stderr, "Warning: failed to decode saved tape block (%zu pulses)\n", job->pulse_count);
+            } else {
+                if (!tape_image_add_block(&tape_recorder.recorded, block.data, block.length, block.pause_ms, 1)) {
+                    fprintf(stderr, "Warning: failed to store recorded tape block\n");
+                }
+                free(block.data);
+            }
+        }
+        tape_recorder_append_block_audio(job->pulses,
+                                         job->pulse_count,
+                                         job->block_start_level,
+                                         job->last_level,
+                                         job->idle_cycles);
+    }
+
+    if (job->write_output) {
+        if (!tape_recorder_write_output()) {
+            fprintf(stderr, "Failed to save tape recording\n");
+        }
+    }
+
+    tape_arena_release(&job->pulse_arena);
+    free(job);
+}
+
+static int tape_encoder_worker(void* data) {
+    (void)data;
+    SDL_LockMutex(tape_encoder_lock);
+    for (;;) {
+        while (!tape_encoder_queue_head && !tape_encoder_shutdown_requested) {
+            SDL_CondWait(tape_encoder_wake, tape_encoder_lock);
+        }
+        TapeEncodeJob* job = tape_encoder_queue_head;
+        if (!job) {
+            break; // shutdown with the queue drained
+        }
+        tape_encoder_queue_head = job->next;
+        if (!tape_encoder_queue_head) {
+            tape_encoder_queue_tail = NULL;
+        }
+        tape_encoder_busy = 1;
+        SDL_UnlockMutex(tape_encoder_lock);
+
+        tape_encoder_process_job(job);
+
+        SDL_LockMutex(tape_encoder_lock);
+        tape_encoder_busy = 0;
+        if (!tape_encoder_queue_head) {
+            SDL_CondBroadcast(tape_encoder_idle);
+        }
+    }
+    SDL_UnlockMutex(tape_encoder_lock);
+    return 0;
+}
+
+static int tape_encoder_start(void) {
+    if (tape_encoder_thread) {
+        return 1;
+    }
+    if (!tape_encoder_lock) {
+        tape_encoder_lock = SDL_CreateMutex();
+    }
+    if (!tape_encoder_wake) {
+        tape_encoder_wake = SDL_CreateCond();
+    }
+    if (!tape_encoder_idle) {
+        tape_encoder_idle = SDL_CreateCond();
+    }
+    if (!tape_encoder_lock || !tape_encoder_wake || !tape_encoder_idle) {
+        fprintf(stderr, "Warning: tape encoder thread unavailable (%s); encoding synchronously\n", SDL_GetError());
+        return 0;
+    }
+    tape_encoder_shutdown_requested = 0;
+    tape_encoder_thread = SDL_CreateThread(tape_encoder_worker, "tape-encoder", NULL);
+    if (!tape_encoder_thread) {
+        fprintf(stderr, "Warning: tape encoder thread unavailable (%s); encoding synchronously\n", SDL_GetError());
+        return 0;
+    }
+    return 1;
+}
+
+static void tape_encoder_submit(TapeEncodeJob* job) {
+    if (!tape_encoder_thread) {
+        // No worker available: encode on the calling thread as before.
+        tape_encoder_process_job(job);
+        return;
+    }
+    SDL_LockMutex(tape_encoder_lock);
+    job->next = NULL;
+    if (tape_encoder_queue_tail) {
+        tape_encoder_queue_tail->next = job;
+    } else {
+        tape_encoder_queue_head = job;
+    }
+    tape_encoder_queue_tail = job;
+    SDL_CondSignal(tape_encoder_wake);
+    SDL_UnlockMutex(tape_encoder_lock);
+}
+
+static void tape_encoder_drain(void) {
+    if (!tape_encoder_thread) {
+        return;
+    }
+    SDL_LockMutex(tape_encoder_lock);
+    while (tape_encoder_queue_head || tape_encoder_busy) {
+        SDL_CondWait(tape_encoder_idle, tape_encoder_lock);
+    }
+    SDL_UnlockMutex(tape_encoder_lock);
+}
+
+static void tape_encoder_stop(void) {
+    if (!tape_encoder_thread) {
+        return;
+    }
+    SDL_LockMutex(tape_encoder_lock);
+    tape_encoder_shutdown_requested = 1;
+    SDL_CondBroadcast(tape_encoder_wake);
+    SDL_UnlockMutex(tape_encoder_lock);
+    SDL_WaitThread(tape_encoder_thread, NULL);
+    tape_encoder_thread = NULL;
+}
+
 static void tape_recorder_enable(const char* path, TapeOutputFormat format) {
+    tape_encoder_drain();
     if (!path || !*path) {
         tape_output_path_storage[0] = '\0';
     }
@@ -7710,6 +9679,9 @@ static void tape_recorder_enable(const char* path, TapeOutputFormat format) {
     tape_recorder_reset_audio();
     tape_recorder_reset_wav_prefix();
     tape_recorder.idle_start_tstate = 0;
+    if (tape_recorder.enabled) {
+        (void)tape_encoder_start();
+    }
 }
 
 static int tape_recorder_start_session(uint64_t current_t_state, int append_mode) {
@@ -7723,6 +9695,10 @@ static int tape_recorder_start_session(uint64_t current_t_state, int append_mode
         return 0;
     }
 
+    // Any jobs from a previous session must land in recorded/audio buffers
+    // before they are reset below.
+    tape_encoder_drain();
+
     int use_append = (append_mode && tape_recorder.output_format == TAPE_OUTPUT_WAV) ? 1 : 0;
     tape_recorder_reset_pulses();
     tape_free_image(&tape_recorder.recorded);
@@ -7807,12 +9783,20 @@ static void tape_recorder_stop_session(uint64_t current_t_state, int finalize_ou
     speaker_tape_record_level = 1;
     speaker_update_output(current_t_state, 1);
 
-    if (finalize_output && tape_recorder.session_dirty) {
-        if (!tape_recorder_write_output()) {
+    if (finalize_output) {
+        TapeEncodeJob* job = (TapeEncodeJob*)calloc(1, sizeof(TapeEncodeJob));
+        if (job) {
+            job->write_output = 1;
+            tape_encoder_submit(job);
+        } else if (!tape_recorder_write_output()) {
             fprintf(stderr, "Failed to save tape recording\n");
         }
     }
 
+    // The on-disk capture must be complete before the same-file WAV reload
+    // below (or the caller's teardown) looks at it.
+    tape_encoder_drain();
+
     if (tape_recorder.output_format == TAPE_OUTPUT_WAV) {
         tape_wav_shared_position_tstates = 0;
         if (tape_input_format == TAPE_FORMAT_WAV &&
@@ -7821,6 +9805,7 @@ static void tape_recorder_stop_session(uint64_t current_t_state, int finalize_ou
             strcmp(tape_input_path, tape_recorder.output_path) == 0) {
             if (!tape_load_wav(tape_input_path, &tape_playback)) {
                 tape_waveform_reset(&tape_playback.waveform);
+                tape_wav_stream_close(&tape_playback);
                 tape_input_enabled = 0;
             } else {
                 tape_reset_playback(&tape_playback);
@@ -7841,7 +9826,10 @@ static int tape_recorder_append_pulse(uint64_t duration) {
     }
     if (tape_recorder.pulse_count == tape_recorder.pulse_capacity) {
         size_t new_capacity = tape_recorder.pulse_capacity ? tape_recorder.pulse_capacity * 2 : 512;
-        TapePulse* new_pulses = (TapePulse*)realloc(tape_recorder.pulses, new_capacity * sizeof(TapePulse));
+        TapePulse* new_pulses = (TapePulse*)tape_arena_grow(&tape_recorder.pulse_arena,
+                                                            tape_recorder.pulses,
+                                                            tape_recorder.pulse_capacity * sizeof(TapePulse),
+                                                            new_capacity * sizeof(TapePulse));
         if (!new_pulses) {
             return 0;
         }
@@ -7910,7 +9898,10 @@ static int tape_recorder_append_audio_samples(int level, size_t sample_count) {
         while (new_capacity < required) {
             new_capacity *= 2;
         }
-        int16_t* new_samples = (int16_t*)realloc(tape_recorder.audio_samples, new_capacity * sizeof(int16_t));
+        int16_t* new_samples = (int16_t*)tape_arena_grow(&tape_recorder.audio_arena,
+                                                         tape_recorder.audio_samples,
+                                                         tape_recorder.audio_sample_capacity * sizeof(int16_t),
+                                                         new_capacity * sizeof(int16_t));
         if (!new_samples) {
             return 0;
         }
@@ -7930,24 +9921,28 @@ static int tape_recorder_append_audio_samples(int level, size_t sample_count) {
     return 1;
 }
 
-static void tape_recorder_append_block_audio(uint64_t idle_cycles) {
+static void tape_recorder_append_block_audio(const TapePulse* pulses,
+                                             size_t pulse_count,
+                                             int block_start_level,
+                                             int last_level,
+                                             uint64_t idle_cycles) {
     if (tape_recorder.output_format != TAPE_OUTPUT_WAV) {
         return;
     }
 
-    if (tape_recorder.pulse_count == 0) {
-        if (idle_cycles > 0 && tape_recorder.last_level >= 0) {
+    if (pulse_count == 0) {
+        if (idle_cycles > 0 && last_level >= 0) {
             size_t idle_samples = tape_recorder_samples_from_tstates(idle_cycles);
-            if (!tape_recorder_append_audio_samples(tape_recorder.last_level ? 1 : 0, idle_samples)) {
+            if (!tape_recorder_append_audio_samples(last_level ? 1 : 0, idle_samples)) {
                 fprintf(stderr, "Warning: failed to store recorded tape audio\n");
             }
         }
         return;
     }
 
-    int level = tape_recorder.block_start_level ? 1 : 0;
-    for (size_t i = 0; i < tape_recorder.pulse_count; ++i) {
-        uint32_t duration = tape_recorder.pulses[i].duration;
+    int level = block_start_level ? 1 : 0;
+    for (size_t i = 0; i < pulse_count; ++i) {
+        uint32_t duration = pulses[i].duration;
         size_t samples = tape_recorder_samples_from_tstates(duration);
         if (!tape_recorder_append_audio_samples(level, samples)) {
             fprintf(stderr, "Warning: failed to store recorded tape audio\n");
@@ -7956,9 +9951,9 @@ static void tape_recorder_append_block_audio(uint64_t idle_cycles) {
         level = level ? 0 : 1;
     }
 
-    if (idle_cycles > 0 && tape_recorder.last_level >= 0) {
+    if (idle_cycles > 0 && last_level >= 0) {
         size_t idle_samples = tape_recorder_samples_from_tstates(idle_cycles);
-        if (!tape_recorder_append_audio_samples(tape_recorder.last_level ? 1 : 0, idle_samples)) {
+        if (!tape_recorder_append_audio_samples(last_level ? 1 : 0, idle_samples)) {
             fprintf(stderr, "Warning: failed to store recorded tape audio\n");
         }
     }
@@ -8367,21 +10362,25 @@ static int tape_recorder_finalize_block(uint64_t current_t_state, int force_flus
         }
     }
 
-    size_t pulse_count = tape_recorder.pulse_count;
-    if (tape_recorder.output_format == TAPE_OUTPUT_TAP && pulse_count >= 100) {
-        TapeBlock block = {0};
-        if (!tape_decode_pulses_to_block(tape_recorder.pulses, pulse_count, pause_ms, &block)) {
-            fprintf(stderr, "Warning: failed to decode saved tape block (%zu pulses)\n", pulse_count);
-        } else {
-            if (!tape_image_add_block(&tape_recorder.recorded, block.data, block.length, block.pause_ms)) {
-                fprintf(stderr, "Warning: failed to store recorded tape block\n");
-            }
-            free(block.data);
-        }
+    TapeEncodeJob* job = (TapeEncodeJob*)calloc(1, sizeof(TapeEncodeJob));
+    if (!job) {
+        fprintf(stderr, "Warning: failed to queue recorded tape block\n");
+    } else {
+        // Hand the pulse buffer (arena and all) to the worker and start the
+        // next block on a fresh arena; the emulation thread does no decoding.
+        job->pulses = tape_recorder.pulses;
+        job->pulse_count = tape_recorder.pulse_count;
+        job->pulse_arena = tape_recorder.pulse_arena;
+        job->pause_ms = pause_ms;
+        job->idle_cycles = idle_cycles;
+        job->block_start_level = tape_recorder.block_start_level;
+        job->last_level = tape_recorder.last_level;
+        tape_recorder.pulses = NULL;
+        tape_recorder.pulse_capacity = 0;
+        memset(&tape_recorder.pulse_arena, 0, sizeof(tape_recorder.pulse_arena));
+        tape_encoder_submit(job);
     }
 
-    tape_recorder_append_block_audio(idle_cycles);
-
     tape_recorder.block_active = 0;
     tape_recorder.pulse_count = 0;
     tape_recorder.last_transition_tstate = current_t_state;
@@ -8507,8 +10506,12 @@ static void tape_shutdown(void) {
     tape_manager_hide();
     tape_pause_playback(&tape_playback, total_t_states);
     tape_recorder_stop_session(total_t_states, 1);
+    tape_encoder_stop();
+    tape_browser_scan_stop();
     tape_free_image(&tape_playback.image);
     tape_waveform_reset(&tape_playback.waveform);
+    tape_free_block_index(&tape_playback);
+    tape_wav_stream_close(&tape_playback);
     tape_free_image(&tape_recorder.recorded);
     tape_recorder_reset_pulses();
     tape_recorder_reset_audio();
@@ -8663,6 +10666,108 @@ static int tape_autoload_fast_forward_active(void) {
             tape_autoload_pending_play || tape_playback.playing);
 }
 
+// --- Main-loop event scheduler ---
+// The ULA queue, tape deck, recorder, autoload driver and input replay only
+// need attention at known t-states, so the CPU loop tracks the earliest of
+// their deadlines and skips the calls until it is reached. The deadline is recomputed
+// after each service pass; anything that changes subsystem state outside a
+// pass (port writes, UI actions) calls scheduler_invalidate() to force the
+// next instruction boundary to service and recompute.
+static uint64_t scheduler_next_deadline = 0;
+
+static void scheduler_invalidate(void) {
+    scheduler_next_deadline = 0;
+}
+
+static uint64_t ula_next_deadline(void) {
+    // Queued writes are always drained on the next pass.
+    return ula_write_count > 0 ? 0 : UINT64_MAX;
+}
+
+static uint64_t tape_next_deadline(void) {
+    const TapePlaybackState* state = &tape_playback;
+    if (!tape_input_enabled || !state->playing) {
+        return UINT64_MAX;
+    }
+    int use_waveform = (state->format == TAPE_FORMAT_WAV) ||
+                       (state->use_waveform_playback && state->waveform.count > 0);
+    if (use_waveform) {
+        return state->next_transition_tstate;
+    }
+    if (state->phase == TAPE_PHASE_PAUSE) {
+        return state->pause_end_tstate;
+    }
+    if (state->phase == TAPE_PHASE_DONE || state->phase == TAPE_PHASE_IDLE) {
+        return UINT64_MAX;
+    }
+    return state->next_transition_tstate;
+}
+
+static uint64_t tape_recorder_next_deadline(void) {
+    if (!tape_recorder.enabled || !tape_recorder.recording) {
+        return UINT64_MAX;
+    }
+    uint64_t deadline = UINT64_MAX;
+    if (tape_recorder.block_active && tape_recorder.pulse_count > 0) {
+        deadline = tape_recorder.last_transition_tstate + TAPE_SILENCE_THRESHOLD_TSTATES;
+    }
+    if (tape_recorder.idle_start_tstate > 0 && tape_recorder.session_dirty) {
+        uint64_t autostop = tape_recorder.idle_start_tstate + TAPE_RECORDER_AUTOSTOP_TSTATES;
+        if (autostop < deadline) {
+            deadline = autostop;
+        }
+    }
+    return deadline;
+}
+
+static uint64_t tape_autoload_next_deadline(void) {
+    if (!tape_autoload_active) {
+        return UINT64_MAX;
+    }
+    if (tape_autoload_waiting) {
+        return tape_autoload_start_time;
+    }
+    if (tape_autoload_sequence.active) {
+        const AutoKeyStep* step = &tape_autoload_sequence.steps[tape_autoload_sequence.index];
+        return tape_autoload_sequence.step_start_tstate + step->duration_tstates;
+    }
+    if (tape_autoload_pending_play) {
+        return 0;
+    }
+    if (tape_autoload_play_started && !tape_playback.playing) {
+        return 0;
+    }
+    // Waiting for playback to finish; the tape deadline wakes us when it does.
+    return UINT64_MAX;
+}
+
+static void scheduler_service(uint64_t current_t_state) {
+    ula_process_port_events(current_t_state);
+    tape_update(current_t_state);
+    tape_recorder_update(current_t_state, 0);
+    tape_autoload_update(current_t_state);
+    input_replay_apply(current_t_state);
+
+    uint64_t next = ula_next_deadline();
+    uint64_t deadline = tape_next_deadline();
+    if (deadline < next) {
+        next = deadline;
+    }
+    deadline = tape_recorder_next_deadline();
+    if (deadline < next) {
+        next = deadline;
+    }
+    deadline = tape_autoload_next_deadline();
+    if (deadline < next) {
+        next = deadline;
+    }
+    deadline = input_replay_next_deadline();
+    if (deadline < next) {
+        next = deadline;
+    }
+    scheduler_next_deadline = next;
+}
+
 typedef struct {
     uint8_t type;
     uint16_t length;
@@ -8936,12 +11041,6 @@ static size_t beeper_catch_up_to(double catch_up_position, double playback_posit
 }
 
 static void beeper_push_event(uint64_t t_state, int level) {
-    int locked_audio = 0;
-    if (audio_available) {
-        SDL_LockAudio();
-        locked_audio = 1;
-    }
-
     uint64_t original_t_state = t_state;
     int was_idle = beeper_idle_log_active;
     double playback_snapshot = beeper_playback_position;
@@ -8964,7 +11063,13 @@ static void beeper_push_event(uint64_t t_state, int level) {
                 playback_snapshot,
                 pending_before);
 
+            if (audio_available) {
+                SDL_LockAudio();
+            }
             beeper_force_resync(t_state);
+            if (audio_available) {
+                SDL_UnlockAudio();
+            }
             playback_snapshot = beeper_playback_position;
             pending_before = 0;
             was_idle = 0;
@@ -9023,7 +11128,9 @@ static void beeper_push_event(uint64_t t_state, int level) {
 
                         double playback_snapshot = beeper_playback_position;
                         size_t pending_before = beeper_pending_event_count();
+                        SDL_LockAudio();
                         size_t consumed = beeper_catch_up_to(catch_up_position, playback_snapshot);
+                        SDL_UnlockAudio();
                         double new_latency_cycles = (double)t_state - beeper_playback_position;
                         double queued_samples_before = latency_cycles / beeper_cycles_per_sample;
                         double queued_samples_after = new_latency_cycles / beeper_cycles_per_sample;
@@ -9095,18 +11202,27 @@ static void beeper_push_event(uint64_t t_state, int level) {
         beeper_idle_log_active = 0;
     }
 
-    size_t next_tail = (beeper_event_tail + 1) % BEEPER_EVENT_CAPACITY;
-    if (next_tail == beeper_event_head) {
-        beeper_event_head = (beeper_event_head + 1) % BEEPER_EVENT_CAPACITY;
+    size_t tail = atomic_load_explicit(&beeper_event_tail, memory_order_relaxed);
+    size_t next_tail = (tail + 1) % BEEPER_EVENT_CAPACITY;
+    if (next_tail == atomic_load_explicit(&beeper_event_head, memory_order_acquire)) {
+        // Ring full (rare): evict the oldest event under the audio lock so
+        // the head update cannot race the consumer popping the same slot.
+        if (audio_available) {
+            SDL_LockAudio();
+        }
+        if (next_tail == beeper_event_head) {
+            beeper_event_head = (beeper_event_head + 1) % BEEPER_EVENT_CAPACITY;
+            ++perf_counters.beeper_events_dropped;
+        }
+        if (audio_available) {
+            SDL_UnlockAudio();
+        }
     }
 
-    beeper_events[beeper_event_tail].t_state = t_state;
-    beeper_events[beeper_event_tail].level = (int8_t)level;
-    beeper_event_tail = next_tail;
-
-    if (locked_audio) {
-        SDL_UnlockAudio();
-    }
+    beeper_events[tail].t_state = t_state;
+    beeper_events[tail].level = (int8_t)level;
+    atomic_store_explicit(&beeper_event_tail, next_tail, memory_order_release);
+    ++perf_counters.beeper_events_queued;
 }
 
 void io_write(uint16_t port, uint8_t value) {
@@ -9260,18 +11376,115 @@ static inline void set_block_io_flags(Z80* cpu, uint8_t value, uint8_t offset, u
     set_xy_flags(cpu, sum8);
 }
 
-static inline void set_flags_szp(Z80* cpu,uint8_t r){set_flag(cpu,FLAG_S,r&0x80);set_flag(cpu,FLAG_Z,r==0);uint8_t p=0;uint8_t t=r;for(int i=0;i<8;i++){if(t&1)p=!p;t>>=1;}set_flag(cpu,FLAG_PV,!p);set_xy_flags(cpu,r);}
+// --- Flag lookup tables ---
+// The 8-bit arithmetic/logic helpers below are the hottest code in the
+// interpreter, and the per-operation flag rebuilds (branchy set_flag chains
+// plus the bit-twiddled parity loop) dominated their cost. The full flag
+// bytes are precomputed once at startup: 256-entry tables for the
+// result-indexed cases (S/Z/parity/XY, INC, DEC) and 64K-entry tables indexed
+// by (A<<8)|operand — one per carry-in value — for add and subtract, so each
+// helper collapses to a table load plus result store. The generators repeat
+// the original flag expressions verbatim; the equivalence unit test holds the
+// two forms together.
+static uint8_t flag_table_szxyp[256];
+static uint8_t flag_table_inc[256];
+static uint8_t flag_table_dec[256];
+static uint8_t flag_table_add[2][0x10000];
+static uint8_t flag_table_sub[2][0x10000];
+
+static void cpu_init_flag_tables(void) {
+    for (unsigned r = 0; r < 256u; ++r) {
+        uint8_t flags = (uint8_t)(r & 0xA8u); // S plus the two XY bits
+        if (r == 0u) {
+            flags |= FLAG_Z;
+        }
+        if (parity_even((uint8_t)r)) {
+            flags |= FLAG_PV;
+        }
+        flag_table_szxyp[r] = flags;
+
+        uint8_t inc_result = (uint8_t)(r + 1u);
+        uint8_t inc_flags = (uint8_t)(inc_result & 0xA8u);
+        if (inc_result == 0u) {
+            inc_flags |= FLAG_Z;
+        }
+        if ((r & 0x0Fu) == 0x0Fu) {
+            inc_flags |= FLAG_H;
+        }
+        if (r == 0x7Fu) {
+            inc_flags |= FLAG_PV;
+        }
+        flag_table_inc[r] = inc_flags;
+
+        uint8_t dec_result = (uint8_t)(r - 1u);
+        uint8_t dec_flags = (uint8_t)((dec_result & 0xA8u) | FLAG_N);
+        if (dec_result == 0u) {
+            dec_flags |= FLAG_Z;
+        }
+        if ((r & 0x0Fu) == 0x00u) {
+            dec_flags |= FLAG_H;
+        }
+        if (r == 0x80u) {
+            dec_flags |= FLAG_PV;
+        }
+        flag_table_dec[r] = dec_flags;
+    }
+
+    for (unsigned c = 0; c < 2u; ++c) {
+        for (unsigned a = 0; a < 256u; ++a) {
+            for (unsigned v = 0; v < 256u; ++v) {
+                unsigned index = (a << 8) | v;
+
+                uint16_t sum = (uint16_t)(a + v + c);
+                uint8_t add_flags = (uint8_t)(sum & 0xA8u);
+                if ((sum & 0xFFu) == 0u) {
+                    add_flags |= FLAG_Z;
+                }
+                if (((a & 0x0Fu) + (v & 0x0Fu) + c) > 0x0Fu) {
+                    add_flags |= FLAG_H;
+                }
+                if (((a ^ v ^ 0x80u) & (sum ^ v) & 0x80u) != 0u) {
+                    add_flags |= FLAG_PV;
+                }
+                if (sum > 0xFFu) {
+                    add_flags |= FLAG_C;
+                }
+                flag_table_add[c][index] = add_flags;
+
+                uint16_t diff = (uint16_t)(a - v - c);
+                uint8_t sub_flags = (uint8_t)((diff & 0xA8u) | FLAG_N);
+                if ((diff & 0xFFu) == 0u) {
+                    sub_flags |= FLAG_Z;
+                }
+                if ((a & 0x0Fu) < ((v & 0x0Fu) + c)) {
+                    sub_flags |= FLAG_H;
+                }
+                if (((a ^ v) & (a ^ diff) & 0x80u) != 0u) {
+                    sub_flags |= FLAG_PV;
+                }
+                if (diff > 0xFFu) {
+                    sub_flags |= FLAG_C;
+                }
+                flag_table_sub[c][index] = sub_flags;
+            }
+        }
+    }
+}
+
+// Keeps the original contract: S/Z/PV/XY come from the result, H/N/C are
+// left untouched for the caller to set.
+static inline void set_flags_szp(Z80* cpu,uint8_t r){cpu->reg_F=(uint8_t)((cpu->reg_F&(FLAG_H|FLAG_N|FLAG_C))|flag_table_szxyp[r]);}
 
 // --- 8-Bit Arithmetic/Logic Helper Functions ---
-void cpu_add(Z80* cpu,uint8_t v){uint16_t r=cpu->reg_A+v;uint8_t hc=((cpu->reg_A&0x0F)+(v&0x0F))>0x0F;set_flag(cpu,FLAG_S,r&0x80);set_flag(cpu,FLAG_Z,(r&0xFF)==0);set_flag(cpu,FLAG_H,hc);set_flag(cpu,FLAG_PV,((cpu->reg_A^v^0x80)&(r^v)&0x80)!=0);set_flag(cpu,FLAG_N,0);set_flag(cpu,FLAG_C,r>0xFF);cpu->reg_A=r&0xFF;set_xy_flags(cpu,cpu->reg_A);}
-void cpu_adc(Z80* cpu,uint8_t v){uint8_t c=get_flag(cpu,FLAG_C);uint16_t r=cpu->reg_A+v+c;uint8_t hc=((cpu->reg_A&0x0F)+(v&0x0F)+c)>0x0F;set_flag(cpu,FLAG_S,r&0x80);set_flag(cpu,FLAG_Z,(r&0xFF)==0);set_flag(cpu,FLAG_H,hc);set_flag(cpu,FLAG_PV,((cpu->reg_A^v^0x80)&(r^v)&0x80)!=0);set_flag(cpu,FLAG_N,0);set_flag(cpu,FLAG_C,r>0xFF);cpu->reg_A=r&0xFF;set_xy_flags(cpu,cpu->reg_A);}
-void cpu_sub(Z80* cpu,uint8_t v,int s){uint16_t r=cpu->reg_A-v;uint8_t hb=((cpu->reg_A&0x0F)<(v&0x0F));set_flag(cpu,FLAG_S,r&0x80);set_flag(cpu,FLAG_Z,(r&0xFF)==0);set_flag(cpu,FLAG_H,hb);set_flag(cpu,FLAG_PV,((cpu->reg_A^v)&(cpu->reg_A^r)&0x80)!=0);set_flag(cpu,FLAG_N,1);set_flag(cpu,FLAG_C,r>0xFF);set_xy_flags(cpu,(uint8_t)r);if(s)cpu->reg_A=r&0xFF;}
-void cpu_sbc(Z80* cpu,uint8_t v){uint8_t c=get_flag(cpu,FLAG_C);uint16_t r=cpu->reg_A-v-c;uint8_t hb=((cpu->reg_A&0x0F)<((v&0x0F)+c));set_flag(cpu,FLAG_S,r&0x80);set_flag(cpu,FLAG_Z,(r&0xFF)==0);set_flag(cpu,FLAG_H,hb);set_flag(cpu,FLAG_PV,((cpu->reg_A^v)&(cpu->reg_A^r)&0x80)!=0);set_flag(cpu,FLAG_N,1);set_flag(cpu,FLAG_C,r>0xFF);cpu->reg_A=r&0xFF;set_xy_flags(cpu,cpu->reg_A);}
-void cpu_and(Z80* cpu,uint8_t v){cpu->reg_A&=v;set_flags_szp(cpu,cpu->reg_A);set_flag(cpu,FLAG_H,1);set_flag(cpu,FLAG_N,0);set_flag(cpu,FLAG_C,0);}
-void cpu_or(Z80* cpu,uint8_t v){cpu->reg_A|=v;set_flags_szp(cpu,cpu->reg_A);set_flag(cpu,FLAG_H,0);set_flag(cpu,FLAG_N,0);set_flag(cpu,FLAG_C,0);}
-void cpu_xor(Z80* cpu,uint8_t v){cpu->reg_A^=v;set_flags_szp(cpu,cpu->reg_A);set_flag(cpu,FLAG_H,0);set_flag(cpu,FLAG_N,0);set_flag(cpu,FLAG_C,0);}
-uint8_t cpu_inc(Z80* cpu,uint8_t v){uint8_t r=v+1;set_flag(cpu,FLAG_S,r&0x80);set_flag(cpu,FLAG_Z,r==0);set_flag(cpu,FLAG_H,(v&0x0F)==0x0F);set_flag(cpu,FLAG_PV,v==0x7F);set_flag(cpu,FLAG_N,0);set_xy_flags(cpu,r);return r;}
-uint8_t cpu_dec(Z80* cpu,uint8_t v){uint8_t r=v-1;set_flag(cpu,FLAG_S,r&0x80);set_flag(cpu,FLAG_Z,r==0);set_flag(cpu,FLAG_H,(v&0x0F)==0x00);set_flag(cpu,FLAG_PV,v==0x80);set_flag(cpu,FLAG_N,1);set_xy_flags(cpu,r);return r;}
+void cpu_add(Z80* cpu,uint8_t v){unsigned index=((unsigned)cpu->reg_A<<8)|v;cpu->reg_F=flag_table_add[0][index];cpu->reg_A=(uint8_t)(cpu->reg_A+v);}
+void cpu_adc(Z80* cpu,uint8_t v){uint8_t c=get_flag(cpu,FLAG_C);unsigned index=((unsigned)cpu->reg_A<<8)|v;cpu->reg_F=flag_table_add[c][index];cpu->reg_A=(uint8_t)(cpu->reg_A+v+c);}
+void cpu_sub(Z80* cpu,uint8_t v,int s){unsigned index=((unsigned)cpu->reg_A<<8)|v;cpu->reg_F=flag_table_sub[0][index];if(s)cpu->reg_A=(uint8_t)(cpu->reg_A-v);}
+void cpu_sbc(Z80* cpu,uint8_t v){uint8_t c=get_flag(cpu,FLAG_C);unsigned index=((unsigned)cpu->reg_A<<8)|v;cpu->reg_F=flag_table_sub[c][index];cpu->reg_A=(uint8_t)(cpu->reg_A-v-c);}
+void cpu_and(Z80* cpu,uint8_t v){cpu->reg_A&=v;cpu->reg_F=(uint8_t)(flag_table_szxyp[cpu->reg_A]|FLAG_H);}
+void cpu_or(Z80* cpu,uint8_t v){cpu->reg_A|=v;cpu->reg_F=flag_table_szxyp[cpu->reg_A];}
+void cpu_xor(Z80* cpu,uint8_t v){cpu->reg_A^=v;cpu->reg_F=flag_table_szxyp[cpu->reg_A];}
+uint8_t cpu_inc(Z80* cpu,uint8_t v){cpu->reg_F=(uint8_t)((cpu->reg_F&FLAG_C)|flag_table_inc[v]);return (uint8_t)(v+1u);}
+uint8_t cpu_dec(Z80* cpu,uint8_t v){cpu->reg_F=(uint8_t)((cpu->reg_F&FLAG_C)|flag_table_dec[v]);return (uint8_t)(v-1u);}
 void cpu_add_hl(Z80* cpu,uint16_t v){uint16_t hl=get_HL(cpu);uint32_t r=hl+v;set_flag(cpu,FLAG_H,((hl&0x0FFF)+(v&0x0FFF))>0x0FFF);set_flag(cpu,FLAG_N,0);set_flag(cpu,FLAG_C,r>0xFFFF);set_HL(cpu,r&0xFFFF);set_xy_flags(cpu,(uint8_t)((r>>8)&0xFF));}
 void cpu_add_ixiy(Z80* cpu,uint16_t* rr,uint16_t v){uint16_t ixy=*rr;uint32_t r=ixy+v;set_flag(cpu,FLAG_H,((ixy&0x0FFF)+(v&0x0FFF))>0x0FFF);set_flag(cpu,FLAG_N,0);set_flag(cpu,FLAG_C,r>0xFFFF);*rr=r&0xFFFF;set_xy_flags(cpu,(uint8_t)((r>>8)&0xFF));}
 void cpu_adc_hl(Z80* cpu,uint16_t v){uint16_t hl=get_HL(cpu);uint8_t c=get_flag(cpu,FLAG_C);uint32_t r=hl+v+c;set_flag(cpu,FLAG_S,(r&0x8000)!=0);set_flag(cpu,FLAG_Z,(r&0xFFFF)==0);set_flag(cpu,FLAG_H,((hl&0x0FFF)+(v&0x0FFF)+c)>0x0FFF);set_flag(cpu,FLAG_PV,(((hl^v^0x8000)&(r^v)&0x8000))!=0);set_flag(cpu,FLAG_N,0);set_flag(cpu,FLAG_C,r>0xFFFF);set_HL(cpu,r&0xFFFF);set_xy_flags(cpu,(uint8_t)((r>>8)&0xFF));}
@@ -9890,22 +12103,12 @@ int cpu_interrupt(Z80* cpu, uint8_t data_bus) {
 }
 
 // --- The Main CPU Execution Step ---
-int cpu_step(Z80* cpu) { // Returns T-states
-    ula_instruction_progress_ptr = NULL;
-    if (cpu->ei_delay) { cpu->iff1 = cpu->iff2 = 1; cpu->ei_delay = 0; }
-    if (cpu->halted) { cpu->reg_R = (cpu->reg_R+1)|(cpu->reg_R&0x80); return 4; }
-
-    int prefix=0;
-    int t_states = 0;
-    ula_instruction_base_tstate = total_t_states;
+// Executes a single already-fetched opcode. fetch_t_states carries the
+// T-states accrued by the opcode/prefix fetches so contention accounting
+// continues from the right point. Shared by both execution cores.
+static inline int cpu_execute_opcode(Z80* cpu, uint8_t opcode, int prefix, int fetch_t_states) {
+    int t_states = fetch_t_states;
     ula_instruction_progress_ptr = &t_states;
-    cpu->reg_R=(cpu->reg_R+1)|(cpu->reg_R&0x80);
-    uint8_t opcode=readByte(cpu->reg_PC++);
-    t_states += 4;
-    
-    if(opcode==0xDD){prefix=1;opcode=readByte(cpu->reg_PC++);cpu->reg_R++;t_states+=4;}
-    else if(opcode==0xFD){prefix=2;opcode=readByte(cpu->reg_PC++);cpu->reg_R++;t_states+=4;}
-    while(opcode==0xDD||opcode==0xFD){prefix=(opcode==0xDD)?1:2;opcode=readByte(cpu->reg_PC++);cpu->reg_R++;t_states+=4;}
 
     switch (opcode) {
         case 0x00: break;
@@ -10091,6 +12294,211 @@ int cpu_step(Z80* cpu) { // Returns T-states
     return t_states;
 }
 
+int cpu_step(Z80* cpu) { // Returns T-states
+    ula_instruction_progress_ptr = NULL;
+    if (cpu->ei_delay) { cpu->iff1 = cpu->iff2 = 1; cpu->ei_delay = 0; }
+    if (cpu->halted) { cpu->reg_R = (cpu->reg_R+1)|(cpu->reg_R&0x80); return 4; }
+
+    int prefix=0;
+    int t_states = 0;
+    ula_instruction_base_tstate = total_t_states;
+    ula_instruction_progress_ptr = &t_states;
+    cpu->reg_R=(cpu->reg_R+1)|(cpu->reg_R&0x80);
+    uint8_t opcode=readByte(cpu->reg_PC++);
+    t_states += 4;
+
+    if(opcode==0xDD){prefix=1;opcode=readByte(cpu->reg_PC++);cpu->reg_R++;t_states+=4;}
+    else if(opcode==0xFD){prefix=2;opcode=readByte(cpu->reg_PC++);cpu->reg_R++;t_states+=4;}
+    while(opcode==0xDD||opcode==0xFD){prefix=(opcode==0xDD)?1:2;opcode=readByte(cpu->reg_PC++);cpu->reg_R++;t_states+=4;}
+
+    return cpu_execute_opcode(cpu, opcode, prefix, t_states);
+}
+
+// --- Table-Driven Fast Core ---
+// Alternative dispatch core selected with --core fast. Each table entry is a
+// thunk that calls cpu_execute_opcode() with the opcode and prefix as compile
+// time constants, so the optimiser folds the switch and every prefix
+// conditional down to the code for that one instruction. The DD and FD
+// variants get their own 256-entry tables, removing the prefix branching from
+// the hot path while sharing the reference implementation of every opcode.
+#define CPU_FAST_OPCODE_LIST(X) \
+    X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) \
+    X(16) X(17) X(18) X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31) \
+    X(32) X(33) X(34) X(35) X(36) X(37) X(38) X(39) X(40) X(41) X(42) X(43) X(44) X(45) X(46) X(47) \
+    X(48) X(49) X(50) X(51) X(52) X(53) X(54) X(55) X(56) X(57) X(58) X(59) X(60) X(61) X(62) X(63) \
+    X(64) X(65) X(66) X(67) X(68) X(69) X(70) X(71) X(72) X(73) X(74) X(75) X(76) X(77) X(78) X(79) \
+    X(80) X(81) X(82) X(83) X(84) X(85) X(86) X(87) X(88) X(89) X(90) X(91) X(92) X(93) X(94) X(95) \
+    X(96) X(97) X(98) X(99) X(100) X(101) X(102) X(103) X(104) X(105) X(106) X(107) X(108) X(109) X(110) X(111) \
+    X(112) X(113) X(114) X(115) X(116) X(117) X(118) X(119) X(120) X(121) X(122) X(123) X(124) X(125) X(126) X(127) \
+    X(128) X(129) X(130) X(131) X(132) X(133) X(134) X(135) X(136) X(137) X(138) X(139) X(140) X(141) X(142) X(143) \
+    X(144) X(145) X(146) X(147) X(148) X(149) X(150) X(151) X(152) X(153) X(154) X(155) X(156) X(157) X(158) X(159) \
+    X(160) X(161) X(162) X(163) X(164) X(165) X(166) X(167) X(168) X(169) X(170) X(171) X(172) X(173) X(174) X(175) \
+    X(176) X(177) X(178) X(179) X(180) X(181) X(182) X(183) X(184) X(185) X(186) X(187) X(188) X(189) X(190) X(191) \
+    X(192) X(193) X(194) X(195) X(196) X(197) X(198) X(199) X(200) X(201) X(202) X(203) X(204) X(205) X(206) X(207) \
+    X(208) X(209) X(210) X(211) X(212) X(213) X(214) X(215) X(216) X(217) X(218) X(219) X(220) X(221) X(222) X(223) \
+    X(224) X(225) X(226) X(227) X(228) X(229) X(230) X(231) X(232) X(233) X(234) X(235) X(236) X(237) X(238) X(239) \
+    X(240) X(241) X(242) X(243) X(244) X(245) X(246) X(247) X(248) X(249) X(250) X(251) X(252) X(253) X(254) X(255)
+
+#define CPU_FAST_DEFINE_BASE(n) \
+    static int cpu_fast_base_##n(Z80* cpu, int fetch_t_states) { return cpu_execute_opcode(cpu, (uint8_t)(n), 0, fetch_t_states); }
+#define CPU_FAST_DEFINE_DD(n) \
+    static int cpu_fast_dd_##n(Z80* cpu, int fetch_t_states) { return cpu_execute_opcode(cpu, (uint8_t)(n), 1, fetch_t_states); }
+#define CPU_FAST_DEFINE_FD(n) \
+    static int cpu_fast_fd_##n(Z80* cpu, int fetch_t_states) { return cpu_execute_opcode(cpu, (uint8_t)(n), 2, fetch_t_states); }
+CPU_FAST_OPCODE_LIST(CPU_FAST_DEFINE_BASE)
+CPU_FAST_OPCODE_LIST(CPU_FAST_DEFINE_DD)
+CPU_FAST_OPCODE_LIST(CPU_FAST_DEFINE_FD)
+
+typedef int (*CpuFastHandler)(Z80* cpu, int fetch_t_states);
+
+#define CPU_FAST_ENTRY_BASE(n) cpu_fast_base_##n,
+#define CPU_FAST_ENTRY_DD(n) cpu_fast_dd_##n,
+#define CPU_FAST_ENTRY_FD(n) cpu_fast_fd_##n,
+static const CpuFastHandler cpu_fast_base_table[256] = { CPU_FAST_OPCODE_LIST(CPU_FAST_ENTRY_BASE) };
+static const CpuFastHandler cpu_fast_dd_table[256] = { CPU_FAST_OPCODE_LIST(CPU_FAST_ENTRY_DD) };
+static const CpuFastHandler cpu_fast_fd_table[256] = { CPU_FAST_OPCODE_LIST(CPU_FAST_ENTRY_FD) };
+
+static int cpu_step_fast(Z80* cpu) { // Returns T-states
+    ula_instruction_progress_ptr = NULL;
+    if (cpu->ei_delay) { cpu->iff1 = cpu->iff2 = 1; cpu->ei_delay = 0; }
+    if (cpu->halted) { cpu->reg_R = (cpu->reg_R+1)|(cpu->reg_R&0x80); return 4; }
+
+    int t_states = 0;
+    ula_instruction_base_tstate = total_t_states;
+    ula_instruction_progress_ptr = &t_states;
+    cpu->reg_R=(cpu->reg_R+1)|(cpu->reg_R&0x80);
+    uint8_t opcode=readByte(cpu->reg_PC++);
+    t_states += 4;
+
+    for (;;) {
+        if (opcode == 0xDD) {
+            opcode = readByte(cpu->reg_PC++);
+            cpu->reg_R++;
+            t_states += 4;
+            if (opcode == 0xDD || opcode == 0xFD) {
+                continue;
+            }
+            return cpu_fast_dd_table[opcode](cpu, t_states);
+        }
+        if (opcode == 0xFD) {
+            opcode = readByte(cpu->reg_PC++);
+            cpu->reg_R++;
+            t_states += 4;
+            if (opcode == 0xDD || opcode == 0xFD) {
+                continue;
+            }
+            return cpu_fast_fd_table[opcode](cpu, t_states);
+        }
+        return cpu_fast_base_table[opcode](cpu, t_states);
+    }
+}
+
+static int (*active_cpu_step)(Z80* cpu) = cpu_step;
+
+// --- Fast boot template ---
+// Booting a stock ROM spends seconds in the RAM test and copyright banner
+// before the machine is usable. With --fast-boot the post-initialisation
+// machine state is cached as a Z80 snapshot in the user snapshots directory,
+// keyed by model and by spectrum_hash_buffer() of the loaded ROM banks so a
+// different ROM never receives a stale template. The first run executes the
+// boot flat out once and captures it; later runs install the template the
+// way snapshot_load_z80() primes cpu and RAM and start at the prompt.
+static int fast_boot_enabled = 0;
+
+static int fast_boot_template_path(char* out, size_t out_size) {
+    if (spectrum_user_snapshots_dir[0] == '\0' || rom_page_count == 0u) {
+        return 0;
+    }
+    uint32_t hash = spectrum_hash_buffer(rom_pages[0], (size_t)rom_page_count * 0x4000u);
+    char name[64];
+    snprintf(name, sizeof(name), "fastboot-%s-%08x.z80",
+             spectrum_model_to_string(spectrum_model), (unsigned int)hash);
+    return spectrum_join_path(spectrum_user_snapshots_dir, name, out, out_size);
+}
+
+static unsigned int fast_boot_frames_for_model(SpectrumModel model) {
+    // Generous margins over the stock ROMs' boot times: the 48K RAM test
+    // settles in about 2.5 s, the 128K-family menus in a little over 4 s.
+    return model == SPECTRUM_MODEL_48K ? 250u : 450u;
+}
+
+// Executes whole frames flat out: the same step/interrupt/scheduler sequence
+// as the main loop, minus rendering, pacing and audio throttling.
+static void fast_boot_run_frames(Z80* cpu, unsigned int frames) {
+    int frame_t_state_accumulator = 0;
+    for (unsigned int frame = 0; frame < frames; ++frame) {
+        while (frame_t_state_accumulator < T_STATES_PER_FRAME) {
+            if (cpu->ei_delay) {
+                cpu->iff1 = cpu->iff2 = 1;
+                cpu->ei_delay = 0;
+            }
+            int t_states = cpu->halted ? 4 : active_cpu_step(cpu);
+            if (t_states <= 0) {
+                t_states = 4;
+            }
+            frame_t_state_accumulator += t_states;
+            total_t_states += t_states;
+            if (total_t_states >= scheduler_next_deadline) {
+                scheduler_service(total_t_states);
+            }
+        }
+        if (cpu->iff1) {
+            int interrupt_t_states = cpu_interrupt(cpu, 0xFF);
+            total_t_states += interrupt_t_states;
+            frame_t_state_accumulator += interrupt_t_states;
+        }
+        frame_t_state_accumulator -= T_STATES_PER_FRAME;
+    }
+}
+
+static int fast_boot_install(Z80* cpu) {
+    char path[PATH_MAX];
+    if (!fast_boot_template_path(path, sizeof(path))) {
+        return 0;
+    }
+    FILE* probe = fopen(path, "rb");
+    if (!probe) {
+        return 0;
+    }
+    fclose(probe);
+    if (!snapshot_load_z80(path, cpu)) {
+        fprintf(stderr, "Fast boot: template '%s' failed to load; booting normally\n", path);
+        return 0;
+    }
+    printf("Fast boot: installed cached machine state from %s\n", path);
+    return 1;
+}
+
+static void fast_boot_prepare(Z80* cpu) {
+    char path[PATH_MAX];
+    if (!fast_boot_template_path(path, sizeof(path))) {
+        fprintf(stderr, "Fast boot: no snapshots directory available; booting normally\n");
+        return;
+    }
+
+    if (!fast_boot_install(cpu)) {
+        printf("Fast boot: no cached template for this ROM; running the boot once to capture it.\n");
+        fast_boot_run_frames(cpu, fast_boot_frames_for_model(spectrum_model));
+
+        // Collapse the boot's border activity into a steady-state colour and
+        // restart the master clock, so the main loop starts at t-state zero
+        // exactly as it does on the install path.
+        if (border_color_event_count > 0) {
+            border_frame_color = (uint8_t)(border_color_events[border_color_event_count - 1].color_idx & 0x07u);
+            border_color_event_count = 0;
+        }
+        border_frame_start_tstate = 0;
+        total_t_states = 0;
+
+        if (!snapshot_save_z80(path, cpu)) {
+            fprintf(stderr, "Fast boot: failed to capture template '%s'\n", path);
+        }
+    }
+
+    speaker_output_level = speaker_calculate_output_level();
+    scheduler_invalidate();
+}
+
 // --- Test Harness Utilities ---
 static void cpu_reset_state(Z80* cpu) {
     memset(cpu, 0, sizeof(*cpu));
@@ -10149,6 +12557,23 @@ static int string_equals_case_insensitive(const char* a, const char* b) {
     return *a == '\0' && *b == '\0';
 }
 
+static int spectrum_configure_model_by_name(const char* name) {
+    if (string_equals_case_insensitive(name, "48k")) {
+        spectrum_configure_model(SPECTRUM_MODEL_48K);
+    } else if (string_equals_case_insensitive(name, "128k")) {
+        spectrum_configure_model(SPECTRUM_MODEL_128K);
+    } else if (string_equals_case_insensitive(name, "plus2a") ||
+               string_equals_case_insensitive(name, "+2a")) {
+        spectrum_configure_model(SPECTRUM_MODEL_PLUS2A);
+    } else if (string_equals_case_insensitive(name, "plus3") ||
+               string_equals_case_insensitive(name, "+3")) {
+        spectrum_configure_model(SPECTRUM_MODEL_PLUS3);
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
 static bool test_cb_sll_register(void) {
     Z80 cpu;
     cpu_reset_state(&cpu);
@@ -10866,87 +13291,1217 @@ static bool test_plus3_peripheral_wait_states(void) {
     total_t_states = 0;
     int plus3_t = cpu_step(&cpu);
 
-    bool wait_states_ok = (plus3_t == base_t + 3);
-    if (!wait_states_ok) {
-        printf("    plus3 peripheral wait debug base=%d wait=%d\n", base_t, plus3_t);
-    }
+    bool wait_states_ok = (plus3_t == base_t + 3);
+    if (!wait_states_ok) {
+        printf("    plus3 peripheral wait debug base=%d wait=%d\n", base_t, plus3_t);
+    }
+
+    spectrum_configure_model(previous_model);
+    memory_clear();
+    spectrum_set_contention_profile(previous_profile);
+    spectrum_set_peripheral_contention_profile(previous_peripheral);
+
+    return wait_states_ok;
+}
+
+static bool test_128k_bank_switching(void) {
+    SpectrumModel previous_model = spectrum_model;
+    spectrum_configure_model(SPECTRUM_MODEL_128K);
+    memory_clear();
+
+    writeByte(0xC000, 0x12);
+    uint8_t before_flag = page_contended[3];
+
+    io_write(0x7FFD, 0x01); // Page bank 1 into 0xC000
+    uint8_t during_flag = page_contended[3];
+    bool saved_bank0 = (ram_pages[0][0] == 0x12) && (memory[0xC000] == 0x00);
+
+    writeByte(0xC000, 0x77);
+    bool bank1_written = (ram_pages[1][0] == 0x77);
+
+    io_write(0x7FFD, 0x00); // Restore bank 0
+    uint8_t after_flag = page_contended[3];
+    bool restored = (memory[0xC000] == 0x12);
+
+    spectrum_configure_model(previous_model);
+    memory_clear();
+
+    return (before_flag == 0u) && (during_flag == 1u) && (after_flag == 0u) && saved_bank0 && bank1_written && restored;
+}
+
+static bool test_128k_contention_penalty(void) {
+    SpectrumModel previous_model = spectrum_model;
+    spectrum_configure_model(SPECTRUM_MODEL_128K);
+    memory_clear();
+
+    Z80 cpu;
+    cpu_reset_state(&cpu);
+    memory[0x0000] = 0x7E; // LD A,(HL)
+    cpu.reg_PC = 0x0000;
+    cpu.reg_H = 0xC0;
+    cpu.reg_L = 0x00;
+    writeByte(0xC000, 0x42); // Bank 0 (uncontended)
+    total_t_states = 14336ULL;
+    int uncontended_t = cpu_step(&cpu);
+    bool base_ok = (cpu.reg_A == 0x42);
+
+    cpu_reset_state(&cpu);
+    cpu.reg_PC = 0x0000;
+    cpu.reg_H = 0xC0;
+    cpu.reg_L = 0x00;
+    memory[0x0000] = 0x7E;
+    io_write(0x7FFD, 0x01); // Switch to contended bank 1
+    writeByte(0xC000, 0x24);
+    total_t_states = 14336ULL;
+    int contended_t = cpu_step(&cpu);
+    bool cont_ok = (cpu.reg_A == 0x24);
+    uint8_t observed_mem = memory[0xC000];
+    uint8_t observed_a = cpu.reg_A;
+    io_write(0x7FFD, 0x00);
+
+    spectrum_configure_model(previous_model);
+    memory_clear();
+
+    bool ok = base_ok && cont_ok && (contended_t > uncontended_t);
+    if (!ok) {
+        printf("    contention debug base=%d cont=%d base_ok=%d cont_ok=%d mem=%02X a=%02X\n",
+               uncontended_t,
+               contended_t,
+               base_ok,
+               cont_ok,
+               observed_mem,
+               observed_a);
+    }
+    return ok;
+}
+
+static bool test_contention_table_matches_reference(void) {
+    SpectrumContentionProfile previous_profile = spectrum_contention_profile;
+    static const SpectrumContentionProfile profiles[] = {
+        CONTENTION_PROFILE_48K,
+        CONTENTION_PROFILE_128K,
+        CONTENTION_PROFILE_128K_PLUS2A,
+        CONTENTION_PROFILE_128K_PLUS3,
+    };
+
+    bool ok = true;
+    for (size_t p = 0; p < sizeof(profiles) / sizeof(profiles[0]) && ok; ++p) {
+        spectrum_set_contention_profile(profiles[p]);
+        for (uint64_t t = 0; t < (uint64_t)T_STATES_PER_FRAME; ++t) {
+            if (ula_contention_penalty(t) != ula_contention_penalty_reference(t)) {
+                printf("    contention table debug profile=%zu t=%" PRIu64 " table=%d ref=%d\n",
+                       p,
+                       t,
+                       ula_contention_penalty(t),
+                       ula_contention_penalty_reference(t));
+                ok = false;
+                break;
+            }
+        }
+        // A t-state beyond one frame must wrap the same way as the reference.
+        if (ok && ula_contention_penalty(T_STATES_PER_FRAME + 14338u) !=
+                      ula_contention_penalty_reference(T_STATES_PER_FRAME + 14338u)) {
+            ok = false;
+        }
+    }
+
+    spectrum_set_contention_profile(previous_profile);
+    return ok;
+}
+
+static const uint8_t fast_core_test_program[] = {
+    0x3E, 0x12,             // LD A,0x12
+    0x06, 0x34,             // LD B,0x34
+    0xDD, 0x21, 0x00, 0x80, // LD IX,0x8000
+    0xDD, 0x36, 0x05, 0x9A, // LD (IX+5),0x9A
+    0xFD, 0x21, 0x0B, 0x80, // LD IY,0x800B
+    0xFD, 0x7E, 0xFA,       // LD A,(IY-6)
+    0xDD, 0xFD, 0xDD, 0x23, // chained prefixes resolving to INC IX
+    0x80,                   // ADD A,B
+    0xCB, 0x27,             // SLA A
+    0xC6, 0x77,             // ADD A,0x77
+    0x76,                   // HALT
+};
+
+static int fast_core_run_test_program(int (*step_fn)(Z80* cpu), Z80* out_cpu) {
+    Z80 cpu;
+    cpu_reset_state(&cpu);
+    memory_clear();
+    memcpy(memory + 0x6000, fast_core_test_program, sizeof(fast_core_test_program));
+    cpu.reg_PC = 0x6000;
+    total_t_states = 0;
+
+    int total = 0;
+    for (int i = 0; i < 64 && !cpu.halted; ++i) {
+        int t = step_fn(&cpu);
+        total += t;
+        total_t_states += (uint64_t)t;
+    }
+
+    *out_cpu = cpu;
+    return total;
+}
+
+static bool test_fast_core_matches_reference(void) {
+    Z80 ref_cpu;
+    Z80 fast_cpu;
+    int ref_t = fast_core_run_test_program(cpu_step, &ref_cpu);
+    int fast_t = fast_core_run_test_program(cpu_step_fast, &fast_cpu);
+
+    memory_clear();
+
+    bool regs_ok = (ref_cpu.reg_A == fast_cpu.reg_A) && (ref_cpu.reg_F == fast_cpu.reg_F) &&
+                   (ref_cpu.reg_B == fast_cpu.reg_B) && (ref_cpu.reg_C == fast_cpu.reg_C) &&
+                   (ref_cpu.reg_D == fast_cpu.reg_D) && (ref_cpu.reg_E == fast_cpu.reg_E) &&
+                   (ref_cpu.reg_H == fast_cpu.reg_H) && (ref_cpu.reg_L == fast_cpu.reg_L) &&
+                   (ref_cpu.reg_IX == fast_cpu.reg_IX) && (ref_cpu.reg_IY == fast_cpu.reg_IY) &&
+                   (ref_cpu.reg_SP == fast_cpu.reg_SP) && (ref_cpu.reg_PC == fast_cpu.reg_PC) &&
+                   (ref_cpu.reg_R == fast_cpu.reg_R);
+    bool timing_ok = (ref_t == fast_t);
+    bool halted_ok = ref_cpu.halted && fast_cpu.halted;
+
+    bool ok = regs_ok && timing_ok && halted_ok;
+    if (!ok) {
+        printf("    fast core debug ref_t=%d fast_t=%d ref A=%02X PC=%04X fast A=%02X PC=%04X\n",
+               ref_t,
+               fast_t,
+               ref_cpu.reg_A,
+               ref_cpu.reg_PC,
+               fast_cpu.reg_A,
+               fast_cpu.reg_PC);
+    }
+    return ok;
+}
+
+static bool test_screen_dirty_cell_tracking(void) {
+    SpectrumModel previous_model = spectrum_model;
+    spectrum_configure_model(SPECTRUM_MODEL_48K);
+    memory_clear();
+
+    memset(screen_dirty_cells, 0, sizeof(screen_dirty_cells));
+    screen_force_full_redraw = 0;
+
+    // Pixel byte for line 65 (third 1, char row 0, scanline 1), column 3.
+    writeByte(0x4000u + 0x0800u + 0x0100u + 3u, 0xFFu);
+    bool pixel_cell_ok = (screen_dirty_cells[8][3] == 1u);
+
+    // Attribute byte for cell row 10, column 17.
+    writeByte((uint16_t)(ATTR_START + 10u * 32u + 17u), 0x47u);
+    bool attr_cell_ok = (screen_dirty_cells[10][17] == 1u);
+
+    // Writes outside the display file must not mark anything.
+    memset(screen_dirty_cells, 0, sizeof(screen_dirty_cells));
+    writeByte((uint16_t)(ATTR_START + 768u), 0x55u);
+    writeByte(0x8000u, 0x55u);
+    bool untouched_ok = true;
+    for (int row = 0; row < SCREEN_CELL_ROWS && untouched_ok; ++row) {
+        for (int col = 0; col < SCREEN_CELL_COLS; ++col) {
+            if (screen_dirty_cells[row][col]) {
+                untouched_ok = false;
+                break;
+            }
+        }
+    }
+
+    spectrum_configure_model(previous_model);
+    memory_clear();
+    screen_force_full_redraw = 1;
+
+    bool ok = pixel_cell_ok && attr_cell_ok && untouched_ok;
+    if (!ok) {
+        printf("    dirty cell debug pixel=%d attr=%d untouched=%d\n",
+               pixel_cell_ok,
+               attr_cell_ok,
+               untouched_ok);
+    }
+    return ok;
+}
+
+static bool test_border_scanline_table(void) {
+    uint64_t saved_frame_start = border_frame_start_tstate;
+    size_t saved_event_count = border_color_event_count;
+
+    border_frame_start_tstate = 0;
+
+    // Frame opens blue, turns red at the top of visible line 100 and yellow
+    // halfway through visible line 200 (2 pixels per t-state => column 176).
+    border_color_events[0].t_state = (uint64_t)(ULA_VISIBLE_TOP_LINES + 100) * ULA_T_STATES_PER_LINE;
+    border_color_events[0].color_idx = 2u;
+    border_color_events[1].t_state = (uint64_t)(ULA_VISIBLE_TOP_LINES + 200) * ULA_T_STATES_PER_LINE + 88u;
+    border_color_events[1].color_idx = 6u;
+    border_color_event_count = 2;
+
+    int first_touched = border_blit_scanlines(1u, 1);
+    bool top_ok = (pixels[10 * TOTAL_WIDTH + 5] == spectrum_colors[1]);
+    bool switch_ok = (pixels[99 * TOTAL_WIDTH + 2] == spectrum_colors[1]) &&
+                     (pixels[100 * TOTAL_WIDTH + 2] == spectrum_colors[2]);
+    bool mixed_ok = (pixels[200 * TOTAL_WIDTH] == spectrum_colors[2]) &&
+                    (pixels[200 * TOTAL_WIDTH + TOTAL_WIDTH - 1] == spectrum_colors[6]);
+    bool bottom_ok = (pixels[250 * TOTAL_WIDTH + 180] == spectrum_colors[6]);
+
+    // A steady yellow frame repaints only the stale lines (including the
+    // uncached mixed one); once the cache matches, the blit is a no-op.
+    border_color_event_count = 0;
+    int second_touched = border_blit_scanlines(6u, 0);
+    bool mixed_repaint_ok = (pixels[200 * TOTAL_WIDTH] == spectrum_colors[6]);
+    int third_touched = border_blit_scanlines(6u, 0);
+
+    border_frame_start_tstate = saved_frame_start;
+    border_color_event_count = saved_event_count;
+    screen_force_full_redraw = 1;
+
+    bool ok = first_touched && top_ok && switch_ok && mixed_ok && bottom_ok &&
+              second_touched && mixed_repaint_ok && !third_touched;
+    if (!ok) {
+        printf("    border table debug touch=%d/%d/%d top=%d switch=%d mixed=%d bottom=%d repaint=%d\n",
+               first_touched,
+               second_touched,
+               third_touched,
+               top_ok,
+               switch_ok,
+               mixed_ok,
+               bottom_ok,
+               mixed_repaint_ok);
+    }
+    return ok;
+}
+
+static bool test_render_frame_exchange(void) {
+    int saved_produce = render_thread_produce_index;
+    int saved_ready = render_thread_ready_index;
+    int saved_consume = render_thread_consume_index;
+    int saved_fresh = render_thread_frame_fresh;
+
+    render_thread_produce_index = 0;
+    render_thread_ready_index = 1;
+    render_thread_consume_index = 2;
+    render_thread_frame_fresh = 0;
+
+    // Nothing published yet: the consumer must see no frame.
+    bool stale_ok = (render_frame_exchange_acquire() == -1);
+
+    // Single publish/acquire round trip delivers the filled buffer.
+    render_thread_buffers[render_thread_produce_index][0] = 0x11111111u;
+    (void)render_frame_exchange_publish();
+    int got = render_frame_exchange_acquire();
+    bool single_ok = (got >= 0) && (render_thread_buffers[got][0] == 0x11111111u);
+
+    // Two publishes without a consume drop the older frame.
+    render_thread_buffers[render_thread_produce_index][0] = 0x22222222u;
+    (void)render_frame_exchange_publish();
+    render_thread_buffers[render_thread_produce_index][0] = 0x33333333u;
+    (void)render_frame_exchange_publish();
+    got = render_frame_exchange_acquire();
+    bool drop_ok = (got >= 0) && (render_thread_buffers[got][0] == 0x33333333u);
+
+    // The three slots must always remain a permutation of {0, 1, 2}.
+    int mask = (1 << render_thread_produce_index) |
+               (1 << render_thread_ready_index) |
+               (1 << render_thread_consume_index);
+    bool distinct_ok = (mask == 0x7);
+
+    render_thread_produce_index = saved_produce;
+    render_thread_ready_index = saved_ready;
+    render_thread_consume_index = saved_consume;
+    render_thread_frame_fresh = saved_fresh;
+
+    bool ok = stale_ok && single_ok && drop_ok && distinct_ok;
+    if (!ok) {
+        printf("    frame exchange debug stale=%d single=%d drop=%d distinct=%d\n",
+               stale_ok,
+               single_ok,
+               drop_ok,
+               distinct_ok);
+    }
+    return ok;
+}
+
+static bool test_ay_block_render_parity(void) {
+    uint8_t saved_registers[16];
+    memcpy(saved_registers, ay_registers, sizeof(saved_registers));
+    double saved_cycles_per_sample = ay_cycles_per_sample;
+
+    // Exercise tone, noise and envelope paths together.
+    ay_write_register(0, 0xFDu);
+    ay_write_register(1, 0x00u);
+    ay_write_register(4, 0x82u);
+    ay_write_register(5, 0x01u);
+    ay_write_register(6, 0x07u);
+    ay_write_register(7, 0x2Au); // tones A+C, noise on B
+    ay_write_register(8, 0x0Fu);
+    ay_write_register(9, 0x0Du);
+    ay_write_register(10, 0x10u); // channel C follows the envelope
+    ay_write_register(11, 0x40u);
+    ay_write_register(12, 0x00u);
+    ay_write_register(13, 0x0Eu);
+
+    // 1750000 / 43750 = 40 cycles per sample exactly, so the batched and
+    // sample-at-a-time paths must agree bit for bit.
+    ay_set_sample_rate(43750);
+
+    enum { AY_PARITY_FRAMES = 2048 };
+    static double block_left[AY_PARITY_FRAMES];
+    static double block_right[AY_PARITY_FRAMES];
+
+    ay_reset_state();
+    ay_render_block(ay_cycles_per_sample, AY_PARITY_FRAMES, block_left, block_right);
+
+    ay_reset_state();
+    bool ok = true;
+    int mismatch_frame = -1;
+    for (int i = 0; i < AY_PARITY_FRAMES; ++i) {
+        double left = 0.0;
+        double right = 0.0;
+        ay_render_block(ay_cycles_per_sample, 1, &left, &right);
+        if (left != block_left[i] || right != block_right[i]) {
+            ok = false;
+            mismatch_frame = i;
+            break;
+        }
+    }
+
+    memcpy(ay_registers, saved_registers, sizeof(saved_registers));
+    ay_cycles_per_sample = saved_cycles_per_sample;
+    ay_reset_state();
+
+    if (!ok) {
+        printf("    AY parity debug first mismatch at frame %d\n", mismatch_frame);
+    }
+    return ok;
+}
+
+static bool test_tap_reference_loading(void) {
+    const char* path = "tap-reference-test.tap";
+    const uint8_t first_payload[4] = {0x00u, 0x01u, 0x02u, 0x03u};
+    const uint8_t second_payload[3] = {0xAAu, 0x55u, 0xFFu};
+
+    FILE* tf = fopen(path, "wb");
+    if (!tf) {
+        printf("    failed to create %s\n", path);
+        return false;
+    }
+    const uint8_t first_length[2] = {4u, 0u};
+    const uint8_t second_length[2] = {3u, 0u};
+    bool wrote = fwrite(first_length, sizeof(first_length), 1, tf) == 1 &&
+                 fwrite(first_payload, sizeof(first_payload), 1, tf) == 1 &&
+                 fwrite(second_length, sizeof(second_length), 1, tf) == 1 &&
+                 fwrite(second_payload, sizeof(second_payload), 1, tf) == 1;
+    fclose(tf);
+    if (!wrote) {
+        remove(path);
+        printf("    failed to write %s\n", path);
+        return false;
+    }
+
+    TapeImage image = {0};
+    bool ok = tape_load_tap(path, &image) != 0;
+    ok = ok && image.count == 2u && image.backing != NULL;
+    if (ok) {
+        ok = image.blocks[0].length == 4u &&
+             image.blocks[0].data_is_reference &&
+             memcmp(image.blocks[0].data, first_payload, sizeof(first_payload)) == 0;
+        ok = ok && image.blocks[1].length == 3u &&
+             image.blocks[1].data_is_reference &&
+             memcmp(image.blocks[1].data, second_payload, sizeof(second_payload)) == 0;
+        // Reference blocks must point into the shared backing, not copies.
+        ok = ok && image.blocks[0].data >= image.backing &&
+             image.blocks[0].data < image.backing + image.backing_size;
+    }
+
+    tape_free_image(&image);
+    remove(path);
+    return ok;
+}
+
+static bool test_tape_waveform_streaming(void) {
+    TapeImage image = {0};
+    uint8_t payload[32];
+    for (size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = (uint8_t)(i * 7u + 3u);
+    }
+    payload[0] = 0x00u; // header flag byte selects the long pilot tone
+    bool ok = tape_image_add_block(&image, payload, sizeof(payload), 500u, 1) != 0;
+    ok = ok && tape_image_add_pure_tone_block(&image, 855u, 6000u, 100u) != 0;
+    ok = ok && tape_image_add_pure_tone_block(&image, 1710u, 6000u, 0u) != 0;
+
+    TapeWaveform full = {0};
+    ok = ok && tape_generate_waveform_from_image(&image, &full) != 0;
+
+    TapePlaybackState state;
+    memset(&state, 0, sizeof(state));
+    state.image = image;
+    ok = ok && tape_waveform_stream_init(&image, &state.waveform) != 0;
+
+    size_t max_window = 0;
+    size_t mismatch_index = (size_t)-1;
+    if (ok) {
+        for (size_t i = 0; i < full.count; ++i) {
+            state.waveform_index = i;
+            if (!tape_playback_has_pulse(&state, i) ||
+                tape_playback_pulse_duration(&state, i) != (uint64_t)full.pulses[i].duration) {
+                ok = false;
+                mismatch_index = i;
+                break;
+            }
+            if (state.waveform.count > max_window) {
+                max_window = state.waveform.count;
+            }
+        }
+    }
+
+    if (ok) {
+        // One pulse past the end must report exhaustion, and the sliding
+        // window must have stayed smaller than the full expansion.
+        state.waveform_index = full.count;
+        ok = !tape_playback_has_pulse(&state, full.count);
+        ok = ok && max_window < full.count;
+        ok = ok && state.waveform.initial_level == full.initial_level;
+    }
+
+    if (!ok && mismatch_index != (size_t)-1) {
+        printf("    streamed waveform diverged at pulse %zu of %zu\n", mismatch_index, full.count);
+    }
+
+    tape_waveform_reset(&state.waveform);
+    tape_waveform_reset(&full);
+    tape_free_image(&image);
+    return ok;
+}
+
+static bool test_tape_block_index(void) {
+    int saved_ear = tape_ear_state;
+    int saved_tape_level = speaker_tape_playback_level;
+    int saved_output_level = speaker_output_level;
+
+    TapeImage image = {0};
+    uint8_t payload[16];
+    for (size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = (uint8_t)(i * 11u + 5u);
+    }
+    payload[0] = 0x00u; // header flag byte selects the long pilot tone
+    // Zero pause after the first block keeps its boundary silence-free so the
+    // jump target's first pulse matches the full expansion exactly.
+    bool ok = tape_image_add_block(&image, payload, sizeof(payload), 0u, 1) != 0;
+    ok = ok && tape_image_add_pure_tone_block(&image, 855u, 4000u, 100u) != 0;
+    ok = ok && tape_image_add_pure_tone_block(&image, 1710u, 4000u, 0u) != 0;
+
+    TapeWaveform full = {0};
+    ok = ok && tape_generate_waveform_from_image(&image, &full) != 0;
+
+    TapePlaybackState state;
+    memset(&state, 0, sizeof(state));
+    state.image = image;
+    state.format = TAPE_FORMAT_TAP;
+    state.use_waveform_playback = 1;
+    ok = ok && tape_waveform_stream_init(&image, &state.waveform) != 0;
+    ok = ok && tape_build_block_index(&state) != 0;
+    ok = ok && state.block_index_count == image.count;
+
+    // Each entry must sit on a pulse boundary whose cumulative duration in
+    // the full expansion matches the recorded t-state offset.
+    if (ok) {
+        ok = state.block_index[0].start_pulse == 0u && state.block_index[0].start_tstates == 0u;
+        uint64_t running = 0;
+        size_t pulse = 0;
+        for (size_t block = 1; ok && block < state.block_index_count; ++block) {
+            const TapeBlockIndexEntry* entry = &state.block_index[block];
+            if (entry->start_pulse <= state.block_index[block - 1].start_pulse ||
+                entry->start_pulse > full.count) {
+                printf("    block %zu start pulse out of order\n", block);
+                ok = false;
+                break;
+            }
+            while (pulse < entry->start_pulse) {
+                running += (uint64_t)full.pulses[pulse].duration;
+                pulse++;
+            }
+            if (entry->start_tstates != running) {
+                printf("    block %zu t-state offset mismatch\n", block);
+                ok = false;
+            }
+        }
+        // The second tone block is 4000 pulses after the first.
+        ok = ok && state.block_index[2].start_pulse - state.block_index[1].start_pulse == 4000u;
+    }
+
+    // Jumping while stopped repositions the cursor and leaves the deck paused
+    // one pulse from the block boundary.
+    if (ok) {
+        const TapeBlockIndexEntry* entry = &state.block_index[1];
+        uint64_t pulse_duration = (uint64_t)full.pulses[entry->start_pulse].duration;
+        int expected_level = (full.initial_level ^ (int)(entry->start_pulse & 1u)) ? 1 : 0;
+        ok = tape_jump_to_block(&state, 1u, 1000u) != 0;
+        ok = ok && state.current_block == 1u &&
+             state.waveform_index == (size_t)entry->start_pulse &&
+             state.position_tstates == entry->start_tstates &&
+             state.level == expected_level &&
+             !state.playing &&
+             state.paused_transition_remaining == pulse_duration;
+        ok = ok && tape_playback_pulse_duration(&state, state.waveform_index) == pulse_duration;
+        if (ok) {
+            ok = tape_resume_playback(&state, 2000u) != 0 && state.playing &&
+                 state.next_transition_tstate == 2000u + pulse_duration;
+        }
+        if (!ok) {
+            printf("    jump debug block=%zu pulse=%zu pos=%llu playing=%d\n",
+                   state.current_block,
+                   state.waveform_index,
+                   (unsigned long long)state.position_tstates,
+                   state.playing);
+        }
+    }
+
+    tape_free_block_index(&state);
+    tape_waveform_reset(&state.waveform);
+    tape_waveform_reset(&full);
+    tape_free_image(&image);
+    tape_ear_state = saved_ear;
+    speaker_tape_playback_level = saved_tape_level;
+    speaker_output_level = saved_output_level;
+    return ok;
+}
+
+static bool test_browser_entry_present(const char* name) {
+    for (int i = 0; i < tape_manager_browser_entry_count; ++i) {
+        if (strcmp(tape_manager_browser_entries[i].name, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool test_tape_browser_cache(void) {
+    const char* dir = "browser-cache-test";
+    const char* subdir = "browser-cache-test/games";
+
+    if (!spectrum_make_directory(dir) || !spectrum_make_directory(subdir)) {
+        printf("    failed to create fixture directory\n");
+        return false;
+    }
+    const char* files[] = {
+        "browser-cache-test/beta.tap",
+        "browser-cache-test/alpha.tzx",
+        "browser-cache-test/notes.txt",
+    };
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        FILE* f = fopen(files[i], "wb");
+        if (!f) {
+            printf("    failed to create %s\n", files[i]);
+            return false;
+        }
+        fclose(f);
+    }
+
+    unsigned scans_before = tape_browser_scan_count;
+    bool ok = tape_manager_refresh_browser(dir) != 0;
+    tape_browser_scan_drain();
+    tape_manager_browser_poll();
+
+    // First visit scans once, filters unknown extensions and sorts the
+    // directory ahead of the tape files.
+    ok = ok && tape_browser_scan_count == scans_before + 1u;
+    ok = ok && tape_browser_published_complete == 1;
+    ok = ok && test_browser_entry_present("games") &&
+         test_browser_entry_present("alpha.tzx") &&
+         test_browser_entry_present("beta.tap") &&
+         !test_browser_entry_present("notes.txt");
+    if (ok) {
+        int base = tape_manager_browser_entry_count - 3;
+        ok = base >= 0 &&
+             strcmp(tape_manager_browser_entries[base].name, "games") == 0 &&
+             strcmp(tape_manager_browser_entries[base + 1].name, "alpha.tzx") == 0 &&
+             strcmp(tape_manager_browser_entries[base + 2].name, "beta.tap") == 0;
+        if (!ok) {
+            printf("    entries not sorted as expected\n");
+        }
+    }
+
+    // Revisiting an unchanged directory must serve the cached listing.
+    int cached_count = tape_manager_browser_entry_count;
+    ok = ok && tape_manager_refresh_browser(dir) != 0;
+    tape_browser_scan_drain();
+    tape_manager_browser_poll();
+    if (ok && tape_browser_scan_count != scans_before + 1u) {
+        printf("    cache hit triggered a rescan\n");
+        ok = false;
+    }
+    ok = ok && tape_manager_browser_entry_count == cached_count;
+
+    // An mtime change invalidates the slot and the rescan sees new files.
+    // (Forced by hand: the filesystem timestamp granularity is too coarse to
+    // rely on inside a unit test.)
+    FILE* extra = fopen("browser-cache-test/gamma.tap", "wb");
+    if (extra) {
+        fclose(extra);
+    }
+    TapeBrowserCacheSlot* slot = ok ? tape_browser_cache_find(tape_manager_browser_path) : NULL;
+    if (slot) {
+        slot->mtime -= 1;
+        ok = tape_manager_refresh_browser(dir) != 0;
+        tape_browser_scan_drain();
+        tape_manager_browser_poll();
+        ok = ok && tape_browser_scan_count == scans_before + 2u &&
+             test_browser_entry_present("gamma.tap");
+        if (!ok) {
+            printf("    mtime invalidation missed the new file\n");
+        }
+    } else if (ok) {
+        printf("    cached slot disappeared\n");
+        ok = false;
+    }
+
+    tape_browser_scan_stop();
+    tape_manager_browser_path[0] = '\0';
+    tape_manager_browser_entry_count = 0;
+    tape_manager_browser_selection = 0;
+    tape_manager_browser_scroll = 0;
+    tape_browser_published_count = -1;
+    tape_browser_published_complete = -1;
+
+    remove("browser-cache-test/gamma.tap");
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        remove(files[i]);
+    }
+#ifdef _WIN32
+    _rmdir(subdir);
+    _rmdir(dir);
+#else
+    rmdir(subdir);
+    rmdir(dir);
+#endif
+    return ok;
+}
+
+static bool test_input_event_replay(void) {
+    const char* path = "input-replay-test.bin";
+    uint8_t saved_matrix[8];
+    memcpy(saved_matrix, keyboard_matrix, sizeof(saved_matrix));
+
+    bool ok = input_record_begin(path) != 0;
+    if (ok) {
+        input_record_key(1000u, 3, 0xFEu);
+        input_record_key(5000u, 3, 0xFFu);
+        input_record_key(5000u, 0, 0xFEu);
+        input_record_finish();
+    }
+
+    ok = ok && input_replay_load(path) != 0;
+    ok = ok && input_replay_count == 3u && input_replay_active && input_replay_mode;
+    ok = ok && input_replay_next_deadline() == 1000u;
+
+    // Events apply at their recorded t-states, not before.
+    if (ok) {
+        memset(keyboard_matrix, 0xFF, sizeof(keyboard_matrix));
+        input_replay_apply(999u);
+        ok = keyboard_matrix[3] == 0xFFu && input_replay_next_deadline() == 1000u;
+        input_replay_apply(1000u);
+        ok = ok && keyboard_matrix[3] == 0xFEu && input_replay_next_deadline() == 5000u;
+        input_replay_apply(6000u);
+        ok = ok && keyboard_matrix[3] == 0xFFu && keyboard_matrix[0] == 0xFEu &&
+             !input_replay_active && input_replay_next_deadline() == UINT64_MAX;
+        if (!ok) {
+            printf("    replay debug next=%zu matrix3=%02X matrix0=%02X\n",
+                   input_replay_next,
+                   keyboard_matrix[3],
+                   keyboard_matrix[0]);
+        }
+    }
+    input_replay_shutdown();
+
+    // A file without the expected header must be rejected.
+    if (ok) {
+        FILE* bad = fopen(path, "wb");
+        if (bad) {
+            fputs("not an input recording", bad);
+            fclose(bad);
+            ok = input_replay_load(path) == 0;
+            if (!ok) {
+                printf("    malformed recording was accepted\n");
+            }
+            input_replay_shutdown();
+        }
+    }
+
+    memcpy(keyboard_matrix, saved_matrix, sizeof(saved_matrix));
+    remove(path);
+    return ok;
+}
+
+static bool test_audio_dump_ring(void) {
+    const char* path = "audio-dump-ring-test.wav";
+    enum { DUMP_TEST_SAMPLES = 10000, DUMP_TEST_BATCH = 700 };
+
+    if (!audio_dump_start(path, 44100u, 1u)) {
+        printf("    failed to start audio dump\n");
+        return false;
+    }
+    bool threaded = audio_dump_writer_thread != NULL;
+
+    // Feed the ring the way the audio callback does: in small batches.
+    Sint16 batch[DUMP_TEST_BATCH];
+    size_t pushed = 0;
+    while (pushed < DUMP_TEST_SAMPLES) {
+        size_t chunk = DUMP_TEST_SAMPLES - pushed;
+        if (chunk > DUMP_TEST_BATCH) {
+            chunk = DUMP_TEST_BATCH;
+        }
+        for (size_t i = 0; i < chunk; ++i) {
+            batch[i] = (Sint16)((pushed + i) * 3u);
+        }
+        audio_dump_write_samples(batch, chunk);
+        pushed += chunk;
+    }
+
+    uint64_t dropped = audio_dump_dropped_samples;
+    audio_dump_finish();
+
+    bool ok = threaded && dropped == 0;
+    if (!ok) {
+        printf("    dump debug threaded=%d dropped=%" PRIu64 "\n", threaded, dropped);
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("    dump file missing\n");
+        remove(path);
+        return false;
+    }
+    uint8_t header[44];
+    ok = ok && fread(header, sizeof(header), 1, file) == 1;
+    uint32_t data_bytes = ok ? ((uint32_t)header[40] | ((uint32_t)header[41] << 8) |
+                                ((uint32_t)header[42] << 16) | ((uint32_t)header[43] << 24))
+                             : 0;
+    ok = ok && data_bytes == DUMP_TEST_SAMPLES * 2u;
+    if (ok) {
+        for (size_t i = 0; i < DUMP_TEST_SAMPLES && ok; ++i) {
+            uint8_t raw[2];
+            if (fread(raw, sizeof(raw), 1, file) != 1) {
+                printf("    dump file truncated at sample %zu\n", i);
+                ok = false;
+                break;
+            }
+            Sint16 value = (Sint16)((uint16_t)raw[0] | ((uint16_t)raw[1] << 8));
+            if (value != (Sint16)(i * 3u)) {
+                printf("    sample %zu mismatch (%d)\n", i, value);
+                ok = false;
+            }
+        }
+    } else if (data_bytes != DUMP_TEST_SAMPLES * 2u) {
+        printf("    data chunk size %u, expected %u\n", data_bytes, DUMP_TEST_SAMPLES * 2u);
+    }
+    fclose(file);
+    remove(path);
+    return ok;
+}
+
+static bool test_rewind_ring(void) {
+    rewind_reset();
+    spectrum_configure_model(SPECTRUM_MODEL_128K);
+
+    Z80 cpu;
+    cpu_reset_state(&cpu);
+
+    for (int bank = 0; bank < 8; ++bank) {
+        memset(ram_pages[bank], 0x10 + bank, 0x4000u);
+    }
+    spectrum_refresh_visible_ram();
+
+    cpu.reg_PC = 0x4001;
+    bool ok = rewind_capture(&cpu) != 0;
+
+    // Touch only bank 2 between captures; everything else must be shared.
+    ram_pages[2][123] = 0x77;
+    rewind_bank_dirty[2] = 1;
+    cpu.reg_PC = 0x5002;
+    ok = ok && rewind_capture(&cpu) != 0;
+
+    if (ok) {
+        const RewindState* first = &rewind_ring[0];
+        const RewindState* second = &rewind_ring[1];
+        if (first->pages[0] != second->pages[0] || first->pages[0]->refcount != 2) {
+            printf("    clean bank was not shared between captures\n");
+            ok = false;
+        }
+        if (ok && first->pages[2] == second->pages[2]) {
+            printf("    dirty bank was shared between captures\n");
+            ok = false;
+        }
+    }
+
+    // Step back to the latest capture, then to the first.
+    cpu.reg_PC = 0x6003;
+    ram_pages[2][123] = 0x99;
+    ok = ok && rewind_step_back(&cpu) != 0;
+    ok = ok && cpu.reg_PC == 0x5002 && ram_pages[2][123] == 0x77;
+    if (!ok) {
+        printf("    latest capture did not restore\n");
+    }
+
+    if (ok) {
+        ok = rewind_step_back(&cpu) != 0 &&
+             cpu.reg_PC == 0x4001 && ram_pages[2][123] == 0x12;
+        if (!ok) {
+            printf("    first capture did not restore\n");
+        }
+    }
+
+    ok = ok && rewind_count == 0 && rewind_step_back(&cpu) == 0;
+
+    rewind_reset();
+    spectrum_configure_model(SPECTRUM_MODEL_48K);
+    return ok;
+}
+
+static bool test_z80_snapshot_roundtrip(void) {
+    const char* path = "snapshot-roundtrip-test.z80";
+    static uint8_t expected[8][0x4000];
+
+    Z80 cpu;
+    cpu_reset_state(&cpu);
+
+    spectrum_configure_model(SPECTRUM_MODEL_128K);
+
+    uint32_t lcg = 99u;
+    for (int bank = 0; bank < 8; ++bank) {
+        for (size_t i = 0; i < 0x4000u; ++i) {
+            lcg = lcg * 1664525u + 1013904223u;
+            expected[bank][i] = (uint8_t)(lcg >> 24);
+        }
+        memset(expected[bank] + 256, 0xED, 300);        // escape-byte runs
+        memset(expected[bank] + 1024, (uint8_t)bank, 2048); // plain RLE runs
+        expected[bank][0] = (uint8_t)bank;
+        memcpy(ram_pages[bank], expected[bank], 0x4000u);
+    }
+    spectrum_refresh_visible_ram();
+
+    cpu.reg_A = 0x12;
+    cpu.reg_F = 0x34;
+    cpu.reg_B = 0x56;
+    cpu.reg_C = 0x78;
+    cpu.reg_PC = 0x8123;
+    cpu.reg_SP = 0x7FF0;
+    cpu.reg_IX = 0xABCD;
+    cpu.reg_IY = 0x5A5A;
+    cpu.reg_I = 0x3F;
+    cpu.reg_R = 0xD3;
+    cpu.alt_reg_A = 0x9C;
+    cpu.iff1 = 1;
+    cpu.iff2 = 1;
+    cpu.interruptMode = 2;
+    border_color_idx = 5;
+    gate_array_7ffd_state = 0x11u;
+    gate_array_1ffd_state = 0u;
+    paging_disabled = 0;
+    current_paged_bank = 1u;
+
+    bool ok = snapshot_save_z80(path, &cpu) != 0;
+
+    // Scramble the machine, then re-enter through the loader.
+    spectrum_configure_model(SPECTRUM_MODEL_48K);
+    for (int bank = 0; bank < 8; ++bank) {
+        memset(ram_pages[bank], 0xAA, 0x4000u);
+    }
+    cpu.reg_A = 0;
+    cpu.reg_PC = 0;
+    cpu.reg_SP = 0;
+    cpu.reg_R = 0;
+    cpu.interruptMode = 0;
+    border_color_idx = 0;
+    gate_array_7ffd_state = 0u;
+
+    ok = ok && snapshot_load_z80(path, &cpu) != 0;
+    ok = ok && spectrum_model == SPECTRUM_MODEL_128K;
+    ok = ok && cpu.reg_A == 0x12 && cpu.reg_F == 0x34 &&
+         cpu.reg_B == 0x56 && cpu.reg_C == 0x78 &&
+         cpu.reg_PC == 0x8123 && cpu.reg_SP == 0x7FF0 &&
+         cpu.reg_IX == 0xABCD && cpu.reg_IY == 0x5A5A &&
+         cpu.reg_I == 0x3F && cpu.reg_R == 0xD3 &&
+         cpu.alt_reg_A == 0x9C && cpu.iff1 == 1 && cpu.interruptMode == 2;
+    ok = ok && border_color_idx == 5 && gate_array_7ffd_state == 0x11u;
+    if (!ok) {
+        printf("    register or paging state did not survive the roundtrip\n");
+    }
+
+    for (int bank = 0; ok && bank < 8; ++bank) {
+        if (memcmp(ram_pages[bank], expected[bank], 0x4000u) != 0) {
+            printf("    bank %d contents did not survive the roundtrip\n", bank);
+            ok = false;
+        }
+    }
+
+    remove(path);
+    spectrum_configure_model(SPECTRUM_MODEL_48K);
+    return ok;
+}
+
+static bool test_scheduler_deadlines(void) {
+    TapePlaybackState saved_playback = tape_playback;
+    TapeRecorder saved_recorder = tape_recorder;
+    int saved_input_enabled = tape_input_enabled;
+    uint64_t saved_deadline = scheduler_next_deadline;
+
+    bool ok = true;
+
+    // Idle subsystems leave the scheduler with nothing to wake up for.
+    memset(&tape_playback, 0, sizeof(tape_playback));
+    memset(&tape_recorder, 0, sizeof(tape_recorder));
+    tape_input_enabled = 0;
+    if (ula_next_deadline() != UINT64_MAX || tape_next_deadline() != UINT64_MAX ||
+        tape_recorder_next_deadline() != UINT64_MAX) {
+        printf("    idle subsystems reported a deadline\n");
+        ok = false;
+    }
+
+    // A playing waveform tape wakes at its next transition.
+    tape_input_enabled = 1;
+    tape_playback.playing = 1;
+    tape_playback.format = TAPE_FORMAT_WAV;
+    tape_playback.next_transition_tstate = 123456u;
+    if (ok && tape_next_deadline() != 123456u) {
+        printf("    waveform playback deadline mismatch\n");
+        ok = false;
+    }
+
+    // A recording session wakes at the earlier of block-silence and autostop.
+    tape_recorder.enabled = 1;
+    tape_recorder.recording = 1;
+    tape_recorder.block_active = 1;
+    tape_recorder.pulse_count = 1;
+    tape_recorder.last_transition_tstate = 1000u;
+    tape_recorder.idle_start_tstate = 500u;
+    tape_recorder.session_dirty = 1;
+    uint64_t silence = 1000u + TAPE_SILENCE_THRESHOLD_TSTATES;
+    uint64_t autostop = 500u + TAPE_RECORDER_AUTOSTOP_TSTATES;
+    uint64_t expected = silence < autostop ? silence : autostop;
+    if (ok && tape_recorder_next_deadline() != expected) {
+        printf("    recorder deadline mismatch\n");
+        ok = false;
+    }
+
+    // Invalidation forces a service pass at the next instruction boundary.
+    scheduler_next_deadline = UINT64_MAX;
+    scheduler_invalidate();
+    if (ok && scheduler_next_deadline != 0u) {
+        printf("    invalidate did not clear the deadline\n");
+        ok = false;
+    }
+
+    tape_playback = saved_playback;
+    tape_recorder = saved_recorder;
+    tape_input_enabled = saved_input_enabled;
+    scheduler_next_deadline = saved_deadline;
+    return ok;
+}
+
+static bool test_tape_arena_allocator(void) {
+    TapeArena arena = {0};
 
-    spectrum_configure_model(previous_model);
-    memory_clear();
-    spectrum_set_contention_profile(previous_profile);
-    spectrum_set_peripheral_contention_profile(previous_peripheral);
+    uint8_t* a = (uint8_t*)tape_arena_alloc(&arena, 24);
+    uint8_t* b = (uint8_t*)tape_arena_alloc(&arena, 3);
+    if (!a || !b || a == b) {
+        tape_arena_release(&arena);
+        printf("    basic allocation failed\n");
+        return false;
+    }
+    if (((uintptr_t)a & 7u) != 0u || ((uintptr_t)b & 7u) != 0u) {
+        tape_arena_release(&arena);
+        printf("    allocations not 8-byte aligned\n");
+        return false;
+    }
+    memset(a, 0xA5, 24);
+    memset(b, 0x5A, 3);
 
-    return wait_states_ok;
-}
+    // b is the tail allocation, so growing it must not move it.
+    uint8_t* b_grown = (uint8_t*)tape_arena_grow(&arena, b, 3, 64);
+    bool ok = (b_grown == b);
+    if (!ok) {
+        printf("    tail allocation did not grow in place\n");
+    }
 
-static bool test_128k_bank_switching(void) {
-    SpectrumModel previous_model = spectrum_model;
-    spectrum_configure_model(SPECTRUM_MODEL_128K);
-    memory_clear();
+    // a is buried; growing it must copy the old contents to a new region.
+    uint8_t* a_grown = (uint8_t*)tape_arena_grow(&arena, a, 24, 48);
+    ok = ok && a_grown != NULL && a_grown != a;
+    for (int i = 0; ok && i < 24; ++i) {
+        if (a_grown[i] != 0xA5) {
+            printf("    grow copy lost contents at offset %d\n", i);
+            ok = false;
+        }
+    }
 
-    writeByte(0xC000, 0x12);
-    uint8_t before_flag = page_contended[3];
+    // Oversized requests get a dedicated slab instead of failing.
+    uint8_t* big = (uint8_t*)tape_arena_alloc(&arena, TAPE_ARENA_SLAB_BYTES * 2u);
+    ok = ok && big != NULL;
+    if (ok) {
+        big[0] = 1;
+        big[TAPE_ARENA_SLAB_BYTES * 2u - 1u] = 1;
+    }
 
-    io_write(0x7FFD, 0x01); // Page bank 1 into 0xC000
-    uint8_t during_flag = page_contended[3];
-    bool saved_bank0 = (ram_pages[0][0] == 0x12) && (memory[0xC000] == 0x00);
+    tape_arena_release(&arena);
+    ok = ok && arena.head == NULL;
+    return ok;
+}
 
-    writeByte(0xC000, 0x77);
-    bool bank1_written = (ram_pages[1][0] == 0x77);
+static bool test_tape_encoder_async(void) {
+    TapeRecorder saved = tape_recorder;
+    memset(&tape_recorder, 0, sizeof(tape_recorder));
+    tape_recorder.output_format = TAPE_OUTPUT_WAV;
+    tape_recorder.sample_rate = 44100u;
+
+    bool started = tape_encoder_start() != 0;
+
+    bool queued = false;
+    size_t expected = 0;
+    TapeEncodeJob* job = (TapeEncodeJob*)calloc(1, sizeof(TapeEncodeJob));
+    if (job) {
+        job->pulses = (TapePulse*)tape_arena_alloc(&job->pulse_arena, 2 * sizeof(TapePulse));
+        if (job->pulses) {
+            job->pulses[0].duration = 35000u;
+            job->pulses[1].duration = 70000u;
+            job->pulse_count = 2;
+            job->block_start_level = 1;
+            job->last_level = 0;
+            expected = tape_recorder_samples_from_tstates(35000u) +
+                       tape_recorder_samples_from_tstates(70000u);
+            tape_encoder_submit(job);
+            queued = true;
+        } else {
+            free(job);
+        }
+    }
+    tape_encoder_drain();
 
-    io_write(0x7FFD, 0x00); // Restore bank 0
-    uint8_t after_flag = page_contended[3];
-    bool restored = (memory[0xC000] == 0x12);
+    bool count_ok = queued && tape_recorder.audio_sample_count == expected;
+    bool level_ok = count_ok && expected >= 2 &&
+                    tape_recorder.audio_samples[0] == TAPE_WAV_AMPLITUDE &&
+                    tape_recorder.audio_samples[expected - 1] == (int16_t)(-TAPE_WAV_AMPLITUDE);
+    bool dirty_ok = tape_recorder.session_dirty == 1;
 
-    spectrum_configure_model(previous_model);
-    memory_clear();
+    tape_recorder_reset_audio();
+    tape_free_image(&tape_recorder.recorded);
+    tape_recorder = saved;
 
-    return (before_flag == 0u) && (during_flag == 1u) && (after_flag == 0u) && saved_bank0 && bank1_written && restored;
+    bool ok = started && count_ok && level_ok && dirty_ok;
+    if (!ok) {
+        printf("    encoder debug started=%d queued=%d samples=%zu expected=%zu dirty=%d\n",
+               started,
+               queued,
+               tape_recorder.audio_sample_count,
+               expected,
+               dirty_ok);
+    }
+    return ok;
 }
 
-static bool test_128k_contention_penalty(void) {
-    SpectrumModel previous_model = spectrum_model;
-    spectrum_configure_model(SPECTRUM_MODEL_128K);
-    memory_clear();
+static bool test_wav_stream_decode(void) {
+    const char* path = "wav-stream-test.wav";
+    enum { WAV_TEST_RATE = 44100, WAV_TEST_SAMPLES = 200000 };
 
-    Z80 cpu;
-    cpu_reset_state(&cpu);
-    memory[0x0000] = 0x7E; // LD A,(HL)
-    cpu.reg_PC = 0x0000;
-    cpu.reg_H = 0xC0;
-    cpu.reg_L = 0x00;
-    writeByte(0xC000, 0x42); // Bank 0 (uncontended)
-    total_t_states = 14336ULL;
-    int uncontended_t = cpu_step(&cpu);
-    bool base_ok = (cpu.reg_A == 0x42);
+    FILE* wf = fopen(path, "wb");
+    if (!wf) {
+        printf("    failed to create %s\n", path);
+        return false;
+    }
+    uint32_t data_bytes = WAV_TEST_SAMPLES * 2u;
+    uint32_t riff_size = 36u + data_bytes;
+    uint32_t byte_rate = WAV_TEST_RATE * 2u;
+    uint8_t header[44];
+    memcpy(header, "RIFF", 4);
+    header[4] = (uint8_t)riff_size;
+    header[5] = (uint8_t)(riff_size >> 8);
+    header[6] = (uint8_t)(riff_size >> 16);
+    header[7] = (uint8_t)(riff_size >> 24);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    header[16] = 16; header[17] = 0; header[18] = 0; header[19] = 0;
+    header[20] = 1; header[21] = 0;  // PCM
+    header[22] = 1; header[23] = 0;  // mono
+    header[24] = (uint8_t)WAV_TEST_RATE;
+    header[25] = (uint8_t)(WAV_TEST_RATE >> 8);
+    header[26] = (uint8_t)(WAV_TEST_RATE >> 16);
+    header[27] = (uint8_t)(WAV_TEST_RATE >> 24);
+    header[28] = (uint8_t)byte_rate;
+    header[29] = (uint8_t)(byte_rate >> 8);
+    header[30] = (uint8_t)(byte_rate >> 16);
+    header[31] = (uint8_t)(byte_rate >> 24);
+    header[32] = 2; header[33] = 0;  // block align
+    header[34] = 16; header[35] = 0; // bits per sample
+    memcpy(header + 36, "data", 4);
+    header[40] = (uint8_t)data_bytes;
+    header[41] = (uint8_t)(data_bytes >> 8);
+    header[42] = (uint8_t)(data_bytes >> 16);
+    header[43] = (uint8_t)(data_bytes >> 24);
+
+    bool wrote = fwrite(header, sizeof(header), 1, wf) == 1;
+    uint32_t lcg = 12345u;
+    int level = 1;
+    uint32_t run_remaining = 0;
+    for (uint32_t i = 0; wrote && i < WAV_TEST_SAMPLES; ++i) {
+        if (run_remaining == 0u) {
+            lcg = lcg * 1664525u + 1013904223u;
+            run_remaining = 1u + (lcg >> 16) % 37u;
+            level = !level;
+        }
+        int16_t sample = level ? 12000 : -12000;
+        uint8_t bytes[2] = {(uint8_t)((uint16_t)sample & 0xFFu), (uint8_t)((uint16_t)sample >> 8)};
+        wrote = fwrite(bytes, sizeof(bytes), 1, wf) == 1;
+        --run_remaining;
+    }
+    fclose(wf);
+    if (!wrote) {
+        remove(path);
+        printf("    failed to write %s\n", path);
+        return false;
+    }
 
-    cpu_reset_state(&cpu);
-    cpu.reg_PC = 0x0000;
-    cpu.reg_H = 0xC0;
-    cpu.reg_L = 0x00;
-    memory[0x0000] = 0x7E;
-    io_write(0x7FFD, 0x01); // Switch to contended bank 1
-    writeByte(0xC000, 0x24);
-    total_t_states = 14336ULL;
-    int contended_t = cpu_step(&cpu);
-    bool cont_ok = (cpu.reg_A == 0x24);
-    uint8_t observed_mem = memory[0xC000];
-    uint8_t observed_a = cpu.reg_A;
-    io_write(0x7FFD, 0x00);
+    int saved_preload = tape_preload_waveform;
 
-    spectrum_configure_model(previous_model);
-    memory_clear();
+    TapePlaybackState full;
+    memset(&full, 0, sizeof(full));
+    tape_preload_waveform = 1;
+    bool ok = tape_load_wav(path, &full) != 0;
+    ok = ok && full.wav_stream.file == NULL && full.waveform.count > 0;
 
-    bool ok = base_ok && cont_ok && (contended_t > uncontended_t);
-    if (!ok) {
-        printf("    contention debug base=%d cont=%d base_ok=%d cont_ok=%d mem=%02X a=%02X\n",
-               uncontended_t,
-               contended_t,
-               base_ok,
-               cont_ok,
-               observed_mem,
-               observed_a);
+    TapePlaybackState streamed;
+    memset(&streamed, 0, sizeof(streamed));
+    tape_preload_waveform = 0;
+    ok = ok && tape_load_wav(path, &streamed) != 0;
+    ok = ok && streamed.wav_stream.file != NULL;
+
+    size_t max_window = 0;
+    if (ok) {
+        ok = streamed.waveform.initial_level == full.waveform.initial_level;
+        for (size_t i = 0; ok && i < full.waveform.count; ++i) {
+            streamed.waveform_index = i;
+            if (!tape_playback_has_pulse(&streamed, i) ||
+                tape_playback_pulse_duration(&streamed, i) != (uint64_t)full.waveform.pulses[i].duration) {
+                printf("    streamed WAV diverged at pulse %zu of %zu\n", i, full.waveform.count);
+                ok = false;
+            }
+            if (streamed.waveform.count > max_window) {
+                max_window = streamed.waveform.count;
+            }
+        }
+    }
+
+    if (ok) {
+        streamed.waveform_index = full.waveform.count;
+        ok = !tape_playback_has_pulse(&streamed, full.waveform.count);
+        ok = ok && max_window < full.waveform.count;
     }
+
+    if (ok) {
+        // Rewind reseeks the stream and must reproduce the opening pulses.
+        streamed.waveform_index = 0;
+        tape_wav_stream_restart(&streamed);
+        ok = tape_playback_has_pulse(&streamed, 0) &&
+             tape_playback_pulse_duration(&streamed, 0) == (uint64_t)full.waveform.pulses[0].duration;
+    }
+
+    tape_wav_stream_close(&streamed);
+    tape_wav_stream_close(&full);
+    tape_waveform_reset(&streamed.waveform);
+    tape_waveform_reset(&full.waveform);
+    tape_preload_waveform = saved_preload;
+    remove(path);
     return ok;
 }
 
@@ -11893,6 +15448,236 @@ static bool run_snapshot_tests(const char* override_dir) {
     return all_passed;
 }
 
+static bool test_pixel_expand_masks(void) {
+    screen_init_pixel_expand_masks();
+    const uint32_t ink = 0xCD00CDFFu;
+    const uint32_t pap = 0x00CD00FFu;
+    for (unsigned value = 0; value < 256u; ++value) {
+        for (unsigned px = 0; px < 8u; ++px) {
+            uint32_t expected = ((value >> (7u - px)) & 1u) ? ink : pap;
+            uint32_t got = pap ^ ((ink ^ pap) & screen_pixel_expand_masks[value][px]);
+            if (got != expected) {
+                printf("    byte %02X pixel %u: got %08X want %08X\n", value, px, got, expected);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool test_flag_table_equivalence(void) {
+    Z80 cpu;
+    cpu_reset_state(&cpu);
+
+    for (unsigned c = 0; c < 2u; ++c) {
+        for (unsigned a = 0; a < 256u; ++a) {
+            for (unsigned v = 0; v < 256u; ++v) {
+                uint16_t sum = (uint16_t)(a + v + c);
+                uint8_t expected = (uint8_t)(sum & 0xA8u);
+                if ((sum & 0xFFu) == 0u) expected |= FLAG_Z;
+                if (((a & 0x0Fu) + (v & 0x0Fu) + c) > 0x0Fu) expected |= FLAG_H;
+                if (((a ^ v ^ 0x80u) & (sum ^ v) & 0x80u) != 0u) expected |= FLAG_PV;
+                if (sum > 0xFFu) expected |= FLAG_C;
+
+                cpu.reg_A = (uint8_t)a;
+                cpu.reg_F = c ? FLAG_C : 0u;
+                cpu_adc(&cpu, (uint8_t)v);
+                if (cpu.reg_A != (uint8_t)sum || cpu.reg_F != expected) {
+                    printf("    ADC %02X+%02X+%u: got A=%02X F=%02X want A=%02X F=%02X\n",
+                           a, v, c, cpu.reg_A, cpu.reg_F, (uint8_t)sum, expected);
+                    return false;
+                }
+
+                uint16_t diff = (uint16_t)(a - v - c);
+                expected = (uint8_t)((diff & 0xA8u) | FLAG_N);
+                if ((diff & 0xFFu) == 0u) expected |= FLAG_Z;
+                if ((a & 0x0Fu) < ((v & 0x0Fu) + c)) expected |= FLAG_H;
+                if (((a ^ v) & (a ^ diff) & 0x80u) != 0u) expected |= FLAG_PV;
+                if (diff > 0xFFu) expected |= FLAG_C;
+
+                cpu.reg_A = (uint8_t)a;
+                cpu.reg_F = c ? FLAG_C : 0u;
+                cpu_sbc(&cpu, (uint8_t)v);
+                if (cpu.reg_A != (uint8_t)diff || cpu.reg_F != expected) {
+                    printf("    SBC %02X-%02X-%u: got A=%02X F=%02X want A=%02X F=%02X\n",
+                           a, v, c, cpu.reg_A, cpu.reg_F, (uint8_t)diff, expected);
+                    return false;
+                }
+
+                if (c == 0u) {
+                    // CP keeps A and takes its XY bits from the result here.
+                    cpu.reg_A = (uint8_t)a;
+                    cpu.reg_F = 0u;
+                    cpu_sub(&cpu, (uint8_t)v, 0);
+                    if (cpu.reg_A != (uint8_t)a || cpu.reg_F != expected) {
+                        printf("    CP %02X,%02X: got A=%02X F=%02X want A=%02X F=%02X\n",
+                               a, v, cpu.reg_A, cpu.reg_F, a, expected);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    for (unsigned r = 0; r < 256u; ++r) {
+        // Independent parity derivation so the table generator cannot share a
+        // bug with the reference.
+        uint8_t ones = 0u;
+        for (unsigned bit = 0; bit < 8u; ++bit) {
+            ones = (uint8_t)(ones + ((r >> bit) & 1u));
+        }
+        uint8_t expected = (uint8_t)(r & 0xA8u);
+        if (r == 0u) expected |= FLAG_Z;
+        if ((ones & 1u) == 0u) expected |= FLAG_PV;
+
+        cpu.reg_A = (uint8_t)r;
+        cpu.reg_F = 0xFFu;
+        cpu_or(&cpu, 0u);
+        if (cpu.reg_F != expected) {
+            printf("    OR %02X,0: got F=%02X want F=%02X\n", r, cpu.reg_F, expected);
+            return false;
+        }
+
+        cpu.reg_A = (uint8_t)r;
+        cpu.reg_F = 0u;
+        cpu_and(&cpu, 0xFFu);
+        if (cpu.reg_F != (uint8_t)(expected | FLAG_H)) {
+            printf("    AND %02X,FF: got F=%02X want F=%02X\n",
+                   r, cpu.reg_F, (uint8_t)(expected | FLAG_H));
+            return false;
+        }
+
+        uint8_t inc_result = (uint8_t)(r + 1u);
+        uint8_t inc_expected = (uint8_t)((inc_result & 0xA8u) | FLAG_C); // carry preserved
+        if (inc_result == 0u) inc_expected |= FLAG_Z;
+        if ((r & 0x0Fu) == 0x0Fu) inc_expected |= FLAG_H;
+        if (r == 0x7Fu) inc_expected |= FLAG_PV;
+        cpu.reg_F = FLAG_C | FLAG_N;
+        if (cpu_inc(&cpu, (uint8_t)r) != inc_result || cpu.reg_F != inc_expected) {
+            printf("    INC %02X: got F=%02X want F=%02X\n", r, cpu.reg_F, inc_expected);
+            return false;
+        }
+
+        uint8_t dec_result = (uint8_t)(r - 1u);
+        uint8_t dec_expected = (uint8_t)((dec_result & 0xA8u) | FLAG_N);
+        if (dec_result == 0u) dec_expected |= FLAG_Z;
+        if ((r & 0x0Fu) == 0x00u) dec_expected |= FLAG_H;
+        if (r == 0x80u) dec_expected |= FLAG_PV;
+        cpu.reg_F = 0u;
+        if (cpu_dec(&cpu, (uint8_t)r) != dec_result || cpu.reg_F != dec_expected) {
+            printf("    DEC %02X: got F=%02X want F=%02X\n", r, cpu.reg_F, dec_expected);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool test_rom_signature_cache(void) {
+    static uint8_t bank[0x4000];
+    uint32_t lcg = 0x5EEDu;
+    for (size_t i = 0; i < sizeof(bank); ++i) {
+        lcg = lcg * 1664525u + 1013904223u;
+        bank[i] = (uint8_t)(lcg >> 24);
+    }
+    memcpy(bank + 0x100, "1982", 4);
+    memcpy(bank + 0x200, "Sinclair Research", 17);
+
+    rom_signature_cache_load();
+    uint32_t hash = spectrum_hash_buffer(bank, sizeof(bank));
+    if (rom_signature_cache_find(hash)) {
+        printf("    random bank already cached before classification\n");
+        return false;
+    }
+
+    if (!spectrum_rom_bank_seems_48k_basic(bank) || spectrum_rom_bank_seems_128k_menu(bank)) {
+        printf("    48K BASIC signature scan gave the wrong verdict\n");
+        return false;
+    }
+
+    RomSignatureCacheEntry* entry = rom_signature_cache_find(hash);
+    if (!entry || entry->seems_basic != 1u || entry->seems_menu != 0u) {
+        printf("    classification was not recorded in the cache\n");
+        return false;
+    }
+
+    // Poison the cached verdict: a second query must come from the cache, not
+    // a rescan, so the flipped flag has to surface in the answer.
+    entry->seems_basic = 0u;
+    int poisoned = spectrum_rom_bank_seems_48k_basic(bank);
+    entry->seems_basic = 1u;
+    if (poisoned) {
+        printf("    second classification rescanned instead of using the cache\n");
+        return false;
+    }
+    return true;
+}
+
+static bool test_fast_boot_template(void) {
+    const char* dir = "fastboot-template-test";
+    if (!spectrum_make_directory(dir)) {
+        printf("    failed to create fixture directory\n");
+        return false;
+    }
+
+    char saved_dir[PATH_MAX];
+    memcpy(saved_dir, spectrum_user_snapshots_dir, sizeof(saved_dir));
+    snprintf(spectrum_user_snapshots_dir, sizeof(spectrum_user_snapshots_dir), "%s", dir);
+
+    // The template file name must be keyed by model and by the hash of the
+    // loaded ROM banks, so a ROM swap can never install a stale state.
+    char path[PATH_MAX];
+    char expected_name[64];
+    uint32_t hash = spectrum_hash_buffer(rom_pages[0], (size_t)rom_page_count * 0x4000u);
+    snprintf(expected_name, sizeof(expected_name), "fastboot-%s-%08x.z80",
+             spectrum_model_to_string(spectrum_model), (unsigned int)hash);
+    bool ok = fast_boot_template_path(path, sizeof(path)) != 0 &&
+              strstr(path, expected_name) != NULL;
+    if (!ok) {
+        printf("    template path is not keyed by model and ROM hash\n");
+    }
+
+    Z80 cpu;
+    cpu_reset_state(&cpu);
+
+    // A missing template must fall through to a normal boot.
+    if (ok) {
+        remove(path);
+        if (fast_boot_install(&cpu) != 0) {
+            printf("    installed a template that does not exist\n");
+            ok = false;
+        }
+    }
+
+    // Capture a primed state, scramble the machine, and install it back.
+    if (ok) {
+        cpu.reg_PC = 0x1234;
+        cpu.reg_SP = 0x7FE8;
+        cpu.interruptMode = 1;
+        memset(ram_pages[5], 0x3C, 0x4000u);
+        spectrum_refresh_visible_ram();
+        ok = snapshot_save_z80(path, &cpu) != 0;
+
+        cpu.reg_PC = 0;
+        cpu.reg_SP = 0;
+        cpu.interruptMode = 0;
+        memset(ram_pages[5], 0x00, 0x4000u);
+
+        ok = ok && fast_boot_install(&cpu) != 0;
+        ok = ok && cpu.reg_PC == 0x1234 && cpu.reg_SP == 0x7FE8 &&
+             cpu.interruptMode == 1 && ram_pages[5][100] == 0x3C;
+        if (!ok) {
+            printf("    cached template did not restore the captured state\n");
+        }
+        remove(path);
+    }
+
+    rmdir(dir);
+    memcpy(spectrum_user_snapshots_dir, saved_dir, sizeof(saved_dir));
+    spectrum_configure_model(SPECTRUM_MODEL_48K);
+    return ok;
+}
+
 static bool run_unit_tests(void) {
     struct {
         const char* name;
@@ -11921,6 +15706,28 @@ static bool run_unit_tests(void) {
         {"+3 peripheral wait-states", test_plus3_peripheral_wait_states},
         {"128K bank paging", test_128k_bank_switching},
         {"128K contention penalties", test_128k_contention_penalty},
+        {"Contention delay table", test_contention_table_matches_reference},
+        {"Fast core parity", test_fast_core_matches_reference},
+        {"Screen dirty-cell tracking", test_screen_dirty_cell_tracking},
+        {"Border scanline table", test_border_scanline_table},
+        {"Render frame exchange", test_render_frame_exchange},
+        {"AY block render parity", test_ay_block_render_parity},
+        {"TAP zero-copy loading", test_tap_reference_loading},
+        {"Tape waveform streaming", test_tape_waveform_streaming},
+        {"Tape block seek index", test_tape_block_index},
+        {"Browser listing cache", test_tape_browser_cache},
+        {"Input event replay", test_input_event_replay},
+        {"Audio dump ring", test_audio_dump_ring},
+        {"WAV streamed decode", test_wav_stream_decode},
+        {"Tape arena allocator", test_tape_arena_allocator},
+        {"Tape encoder worker", test_tape_encoder_async},
+        {"Scheduler deadlines", test_scheduler_deadlines},
+        {"Z80 snapshot roundtrip", test_z80_snapshot_roundtrip},
+        {"Rewind ring capture/restore", test_rewind_ring},
+        {"ROM signature cache", test_rom_signature_cache},
+        {"Fast boot template", test_fast_boot_template},
+        {"Flag table equivalence", test_flag_table_equivalence},
+        {"Pixel expand masks", test_pixel_expand_masks},
     };
 
     bool all_passed = true;
@@ -12098,12 +15905,282 @@ static int run_cpu_tests(const char* rom_dir, const char* snapshot_dir) {
         }
     }
 
-    return overall ? 0 : 1;
+    return overall ? 0 : 1;
+}
+
+// --- Benchmark harness ---
+// Standardized workloads with stable metric names so results can be trended
+// per commit. Runs from the same binary as the test registry (--bench) and
+// writes machine-readable JSON to z80-bench.json alongside the log output.
+typedef struct {
+    const char* name;
+    const char* unit;
+    double (*fn)(void);
+} BenchmarkCase;
+
+static double bench_elapsed_seconds(Uint64 start) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    return (double)(now - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+// Emulated CPU clock rate achieved on a tight RAM-resident loop, in MHz.
+static double bench_cpu_loop_at(uint16_t loop_base, long steps) {
+    Z80 cpu;
+    cpu_reset_state(&cpu);
+    memory_clear();
+    memory[loop_base] = 0x3C;                   // INC A
+    memory[loop_base + 1u] = 0x18;              // JR -3
+    memory[loop_base + 2u] = 0xFD;
+    cpu.reg_PC = loop_base;
+    total_t_states = 0;
+
+    uint64_t emulated = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (long i = 0; i < steps; ++i) {
+        int t_states = cpu_step(&cpu);
+        emulated += (uint64_t)t_states;
+        total_t_states += (uint64_t)t_states;
+    }
+    double seconds = bench_elapsed_seconds(start);
+    return seconds > 0.0 ? (double)emulated / seconds / 1e6 : 0.0;
+}
+
+static double bench_cpu_loop(void) {
+    spectrum_configure_model(SPECTRUM_MODEL_48K);
+    return bench_cpu_loop_at(0x8000u, 20000000L); // uncontended bank
+}
+
+static double bench_cpu_loop_contended(void) {
+    spectrum_configure_model(SPECTRUM_MODEL_48K);
+    return bench_cpu_loop_at(0x4100u, 10000000L); // contended screen bank
+}
+
+// Full-redraw render_screen() throughput in frames per second. Safe without a
+// live renderer: SDL rejects the NULL handles and the pixel conversion still
+// runs, which is the part worth measuring.
+static double bench_render_screen(void) {
+    int saved_headless = headless_mode;
+    headless_mode = 0;
+    spectrum_configure_model(SPECTRUM_MODEL_48K);
+
+    uint32_t lcg = 7u;
+    for (size_t i = 0; i < SCREEN_DISPLAY_BYTES; ++i) {
+        lcg = lcg * 1664525u + 1013904223u;
+        ram_pages[5][i] = (uint8_t)(lcg >> 24);
+    }
+    spectrum_refresh_visible_ram();
+
+    const int frames = 300;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < frames; ++i) {
+        screen_force_full_redraw = 1;
+        render_screen();
+        total_t_states += T_STATES_PER_FRAME;
+    }
+    double seconds = bench_elapsed_seconds(start);
+
+    headless_mode = saved_headless;
+    return seconds > 0.0 ? (double)frames / seconds : 0.0;
+}
+
+// Tape waveform expansion throughput in millions of pulses per second.
+static double bench_tape_waveform(void) {
+    TapeImage image;
+    memset(&image, 0, sizeof(image));
+    for (int i = 0; i < 8; ++i) {
+        if (!tape_image_add_pure_tone_block(&image, 855u, 200000u, 0u)) {
+            tape_free_image(&image);
+            return 0.0;
+        }
+    }
+
+    TapeWaveform waveform;
+    memset(&waveform, 0, sizeof(waveform));
+    Uint64 start = SDL_GetPerformanceCounter();
+    int generated = tape_generate_waveform_from_image(&image, &waveform);
+    double seconds = bench_elapsed_seconds(start);
+
+    double value = 0.0;
+    if (generated && seconds > 0.0) {
+        value = (double)waveform.count / seconds / 1e6;
+    }
+    tape_waveform_reset(&waveform);
+    tape_free_image(&image);
+    return value;
+}
+
+// AY batched mixing throughput in millions of stereo frames per second.
+static double bench_ay_mixer(void) {
+    ay_reset_state_internal();
+    ay_write_register(0, 0xFD);
+    ay_write_register(1, 0x00);
+    ay_write_register(2, 0x85);
+    ay_write_register(3, 0x01);
+    ay_write_register(6, 0x10);
+    ay_write_register(7, 0x2A);
+    ay_write_register(8, 0x0C);
+    ay_write_register(9, 0x0A);
+    ay_write_register(10, 0x10);
+    ay_write_register(11, 0x00);
+    ay_write_register(12, 0x04);
+    ay_write_register(13, 0x0E);
+    ay_set_sample_rate(44100);
+
+    enum { AY_BENCH_BLOCK = 1024 };
+    static double left[AY_BENCH_BLOCK];
+    static double right[AY_BENCH_BLOCK];
+    const long total_frames = 2000000L;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (long rendered = 0; rendered < total_frames; rendered += AY_BENCH_BLOCK) {
+        ay_render_block(ay_cycles_per_sample, AY_BENCH_BLOCK, left, right);
+    }
+    double seconds = bench_elapsed_seconds(start);
+    ay_reset_state_internal();
+    return seconds > 0.0 ? (double)total_frames / seconds / 1e6 : 0.0;
+}
+
+static int run_benchmarks(void) {
+    const BenchmarkCase benchmarks[] = {
+        {"cpu_loop", "emulated_mhz", bench_cpu_loop},
+        {"cpu_loop_contended", "emulated_mhz", bench_cpu_loop_contended},
+        {"render_screen", "frames_per_s", bench_render_screen},
+        {"tape_waveform", "mpulses_per_s", bench_tape_waveform},
+        {"ay_mixer", "mframes_per_s", bench_ay_mixer},
+    };
+    const size_t count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    FILE* out = fopen("z80-bench.json", "w");
+    if (!out) {
+        fprintf(stderr, "Failed to open z80-bench.json: %s\n", strerror(errno));
+        return 1;
+    }
+
+    printf("Running benchmarks...\n");
+    fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < count; ++i) {
+        double value = benchmarks[i].fn();
+        printf("  %-22s %12.3f %s\n", benchmarks[i].name, value, benchmarks[i].unit);
+        fprintf(out,
+                "    {\"name\": \"%s\", \"unit\": \"%s\", \"value\": %.3f}%s\n",
+                benchmarks[i].name,
+                benchmarks[i].unit,
+                value,
+                (i + 1u < count) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    int write_ok = fclose(out) == 0;
+    printf("Benchmark results written to z80-bench.json\n");
+    return write_ok ? 0 : 1;
+}
+
+// --- Batch runner ---
+// Runs many headless emulations from one warm process. The single-translation-
+// unit design keeps the machine state in globals, so in-process threads cannot
+// host multiple machines; instead the parent forks one child per job after the
+// shared startup work (log setup, contention tables, model selection) is done,
+// and fork's copy-on-write pages make each child's machine state independent
+// for free. Each job line supplies its own inputs and exit bounds.
+static const char* batch_jobs_path = NULL;
+static int batch_parallel = 1;
+
+static int batch_read_jobs(const char* path, char*** lines_out, size_t* count_out) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Failed to open batch job file '%s': %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    char** lines = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    char buffer[1024];
+    while (fgets(buffer, sizeof(buffer), file)) {
+        char* cursor = buffer;
+        while (*cursor == ' ' || *cursor == '\t') {
+            ++cursor;
+        }
+        size_t length = strlen(cursor);
+        while (length > 0u && (cursor[length - 1u] == '\n' || cursor[length - 1u] == '\r')) {
+            cursor[--length] = '\0';
+        }
+        if (length == 0u || cursor[0] == '#') {
+            continue;
+        }
+        if (count == capacity) {
+            size_t new_capacity = capacity ? capacity * 2u : 16u;
+            char** grown = realloc(lines, new_capacity * sizeof(char*));
+            if (!grown) {
+                fclose(file);
+                return 0;
+            }
+            lines = grown;
+            capacity = new_capacity;
+        }
+        char* copy = malloc(length + 1u);
+        if (!copy) {
+            fclose(file);
+            return 0;
+        }
+        memcpy(copy, cursor, length + 1u);
+        lines[count++] = copy;
+    }
+    fclose(file);
+
+    *lines_out = lines;
+    *count_out = count;
+    return 1;
+}
+
+// Applies one job line to the global machine configuration. Jobs use a focused
+// subset of the CLI: snapshot/tape/ROM files are inferred by extension exactly
+// like positional arguments, plus --model and the exit bounds that give each
+// run a deterministic end.
+static int batch_apply_job_line(char* line) {
+    for (char* token = strtok(line, " \t"); token; token = strtok(NULL, " \t")) {
+        if (strcmp(token, "--exit-after-frames") == 0) {
+            char* value = strtok(NULL, " \t");
+            if (!value || (exit_after_frames = strtoull(value, NULL, 10)) == 0u) {
+                fprintf(stderr, "Batch job: --exit-after-frames requires a positive count\n");
+                return 0;
+            }
+        } else if (strcmp(token, "--exit-after-tstates") == 0) {
+            char* value = strtok(NULL, " \t");
+            if (!value || (exit_after_tstates = strtoull(value, NULL, 10)) == 0u) {
+                fprintf(stderr, "Batch job: --exit-after-tstates requires a positive count\n");
+                return 0;
+            }
+        } else if (strcmp(token, "--model") == 0) {
+            char* value = strtok(NULL, " \t");
+            if (!value || !spectrum_configure_model_by_name(value)) {
+                fprintf(stderr, "Batch job: unknown model '%s'\n", value ? value : "");
+                return 0;
+            }
+        } else {
+            SnapshotFormat inferred_snapshot = snapshot_format_from_extension(token);
+            TapeFormat inferred_format = tape_format_from_extension(token);
+            if (inferred_snapshot != SNAPSHOT_FORMAT_NONE) {
+                snapshot_input_format = inferred_snapshot;
+                snapshot_set_input_path(token);
+            } else if (inferred_format != TAPE_FORMAT_NONE) {
+                tape_input_format = inferred_format;
+                tape_set_input_path(token);
+            } else {
+                fprintf(stderr, "Batch job: unrecognised token '%s'\n", token);
+                return 0;
+            }
+        }
+    }
+    if (exit_after_frames == 0u && exit_after_tstates == 0u) {
+        fprintf(stderr, "Batch job: needs --exit-after-frames or --exit-after-tstates\n");
+        return 0;
+    }
+    return 1;
 }
 
 static void print_usage(const char* prog) {
     fprintf(stderr,
-            "Usage: %s [--audio-dump <wav_file>] [--beeper-log] [--tape-debug] [--paging-log] [--paging-log-regs] [--ram-hash-log] "
+            "Usage: %s [--audio-dump <wav_file>] [--beeper-log] [--tape-debug] [--tape-preload] [--paging-log] [--paging-log-regs] [--ram-hash-log] "
             "[--model <48k|128k|plus2a|plus3> | --48k | --128k | --plus2a | --plus3] "
             "[--contention <48k|128k|plus2a|plus3>] "
             "[--peripheral <none|if1|plus3>] "
@@ -12111,8 +16188,15 @@ static void print_usage(const char* prog) {
             "[--tap <tap_file> | --tzx <tzx_file> | --tgz <tzx_file> | --wav <wav_file>] "
             "[--snapshot <sna_or_z80>] "
             "[--save-tap <tap_file> | --save-wav <wav_file>] "
+            "[--save-snapshot <z80_file>] [--save-snapshot-at-frame <count>] "
+            "[--rewind] "
             "[--test-rom-dir <dir>] [--snapshot-test-dir <dir>] "
-            "[--run-tests] [--fullscreen] [rom_file]\n",
+            "[--run-tests] [--bench] [--batch <jobs_file> [--parallel <count>]] "
+            "[--headless] [--turbo] [--fast-boot] [--core fast|reference] "
+            "[--record-input <events_file>] [--replay-input <events_file>] "
+            "[--exit-after-frames <count>] [--exit-after-tstates <count>] "
+            "[--frame-skip <count>] [--render-thread] "
+            "[--fullscreen] [rom_file]\n",
             prog);
 }
 
@@ -12203,8 +16287,153 @@ void cleanup_sdl(void) {
     SDL_Quit();
 }
 
+// --- Performance reporting ---
+// Rates are recomputed over a short frame window for the overlay, and a
+// one-line cumulative report goes to the log every few seconds so slow-running
+// field captures carry their own timeline.
+#define PERF_RATE_WINDOW_FRAMES 50u
+#define PERF_REPORT_INTERVAL_FRAMES 500u
+
+static PerfCounters perf_window_base;
+static Uint64 perf_window_start_counter = 0;
+static uint64_t perf_window_index = 0;
+static double perf_rate_mips = 0.0;
+static double perf_rate_contended_pct = 0.0;
+static double perf_rate_fps = 0.0;
+static double perf_rate_beeper_events = 0.0;
+
+static void perf_frame_tick(void) {
+    static uint64_t frames_seen = 0;
+    ++frames_seen;
+    if (frames_seen % PERF_RATE_WINDOW_FRAMES != 0u) {
+        return;
+    }
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (perf_window_start_counter != 0) {
+        double seconds = (double)(now - perf_window_start_counter) /
+                         (double)SDL_GetPerformanceFrequency();
+        if (seconds > 0.0) {
+            uint64_t instructions = perf_counters.instructions_retired - perf_window_base.instructions_retired;
+            uint64_t contended = perf_counters.contended_accesses - perf_window_base.contended_accesses;
+            uint64_t uncontended = perf_counters.uncontended_accesses - perf_window_base.uncontended_accesses;
+            uint64_t rendered = perf_counters.frames_rendered - perf_window_base.frames_rendered;
+            uint64_t queued = perf_counters.beeper_events_queued - perf_window_base.beeper_events_queued;
+            uint64_t accesses = contended + uncontended;
+
+            perf_rate_mips = (double)instructions / seconds / 1e6;
+            perf_rate_contended_pct = accesses > 0u ? 100.0 * (double)contended / (double)accesses : 0.0;
+            perf_rate_fps = (double)rendered / seconds;
+            perf_rate_beeper_events = (double)queued / seconds;
+        }
+    }
+    perf_window_base = perf_counters;
+    perf_window_start_counter = now;
+    ++perf_window_index;
+
+    if (perf_window_index % (PERF_REPORT_INTERVAL_FRAMES / PERF_RATE_WINDOW_FRAMES) == 0u) {
+        printf("[PERF] %.1f MIPS (%.1f%% contended), %.1f fps (%" PRIu64 " skipped), "
+               "beeper %.0f ev/s (%" PRIu64 " dropped), %" PRIu64 " underruns\n",
+               perf_rate_mips,
+               perf_rate_contended_pct,
+               perf_rate_fps,
+               perf_counters.frames_skipped,
+               perf_rate_beeper_events,
+               perf_counters.beeper_events_dropped,
+               perf_counters.audio_underruns);
+    }
+}
+
+static void perf_render_overlay(void) {
+    if (!perf_overlay_visible || headless_mode) {
+        return;
+    }
+
+    const int scale = 1;
+    const int spacing = scale;
+    const int padding = 6;
+    const int line_height = TAPE_OVERLAY_FONT_HEIGHT * scale;
+    const int line_gap = scale;
+
+    const uint32_t panel_background = 0x1C1C1CF0u;
+    const uint32_t panel_border = 0xFFFFFFFFu;
+    const uint32_t title_color = 0xFFFFFFFFu;
+    const uint32_t text_color = 0xDDDDDDFFu;
+
+    char cpu_line[64];
+    char video_line[64];
+    char audio_line[64];
+    snprintf(cpu_line, sizeof(cpu_line), "CPU %7.1f MIPS  CONT %5.1f%%",
+             perf_rate_mips, perf_rate_contended_pct);
+    snprintf(video_line, sizeof(video_line), "VID %7.1f FPS   SKIP %" PRIu64,
+             perf_rate_fps, perf_counters.frames_skipped);
+    snprintf(audio_line, sizeof(audio_line), "SND %7.0f EV/S  DROP %" PRIu64 " UR %" PRIu64,
+             perf_rate_beeper_events,
+             perf_counters.beeper_events_dropped,
+             perf_counters.audio_underruns);
+
+    int panel_width = tape_overlay_text_width("PERF", scale, spacing);
+    const char* lines[] = {cpu_line, video_line, audio_line};
+    for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); ++i) {
+        int width = tape_overlay_text_width(lines[i], scale, spacing);
+        if (width > panel_width) {
+            panel_width = width;
+        }
+    }
+    panel_width += padding * 2;
+    int panel_height = padding * 2 + 4 * line_height + 3 * line_gap;
+
+    tape_overlay_draw_rect(0, 0, panel_width, panel_height, panel_background, panel_border);
+
+    int cursor_x = padding;
+    int cursor_y = padding;
+    tape_overlay_draw_text(cursor_x, cursor_y, "PERF", scale, spacing, title_color);
+    cursor_y += line_height + line_gap;
+    for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); ++i) {
+        tape_overlay_draw_text(cursor_x, cursor_y, lines[i], scale, spacing, text_color);
+        cursor_y += line_height + line_gap;
+    }
+}
+
+// --- Frame skipping ---
+// Decouples emulation speed from rendering: a skipped frame still runs
+// render_screen() so the border event queue and frame bookkeeping drain
+// normally, but all pixel work, texture uploads and the vsync'd present are
+// bypassed. Dirty cells survive skipped frames, so the next rendered frame
+// repaints everything that changed in the meantime.
+static uint64_t frame_skip_interval = 0; // render 1 of every (N+1) frames; 0 = automatic
+static int render_skip_current_frame = 0;
+static uint64_t frame_skip_sequence = 0;
+static Uint64 frame_skip_last_present = 0;
+
+static int frame_render_should_skip(void) {
+    if (headless_mode) {
+        return 0; // headless already bypasses the pixel work
+    }
+    if (frame_skip_interval > 0u) {
+        uint64_t position = frame_skip_sequence++;
+        return (position % (frame_skip_interval + 1u)) != 0u;
+    }
+    if (!turbo_mode && !tape_autoload_fast_forward_active()) {
+        return 0;
+    }
+    // Automatic mode: when emulation is running faster than real time, present
+    // at most at nominal display rate so video stops being the bottleneck.
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 min_interval = SDL_GetPerformanceFrequency() / 50u; // nominal PAL rate
+    if (frame_skip_last_present != 0 && now - frame_skip_last_present < min_interval) {
+        return 1;
+    }
+    frame_skip_last_present = now;
+    return 0;
+}
+
 // --- Render ZX Spectrum Screen ---
+static int screen_last_flash_phase = -1;
+static int screen_overlay_was_visible = 0;
+
 void render_screen(void) {
+    int skip_pixels = headless_mode || render_skip_current_frame;
     uint64_t frame_start = border_frame_start_tstate;
     uint64_t frame_end = frame_start + T_STATES_PER_FRAME;
 
@@ -12223,27 +16452,22 @@ void render_screen(void) {
     }
     border_frame_color = start_color;
 
-    uint32_t base_rgba = spectrum_colors[start_color];
-    size_t total_pixels = (size_t)TOTAL_WIDTH * (size_t)TOTAL_HEIGHT;
-    for (size_t i = 0; i < total_pixels; ++i) {
-        pixels[i] = base_rgba;
+    int flash_phase = (int)(((total_t_states / T_STATES_PER_FRAME) >> 5) & 1ULL);
+    int overlay_visible = (tape_manager_mode != TAPE_MANAGER_MODE_HIDDEN) || perf_overlay_visible;
+    int full_redraw = screen_force_full_redraw ||
+                      overlay_visible || screen_overlay_was_visible ||
+                      flash_phase != screen_last_flash_phase;
+    int border_touched = 0;
+    if (!skip_pixels) {
+        border_touched = border_blit_scanlines(start_color, full_redraw);
     }
 
-    uint64_t segment_start = frame_start;
     uint8_t current_color = start_color;
     size_t event_index = 0;
     while (event_index < border_color_event_count && border_color_events[event_index].t_state < frame_end) {
-        uint64_t event_time = border_color_events[event_index].t_state;
-        if (event_time > segment_start) {
-            border_draw_span(segment_start, event_time, current_color);
-        }
         current_color = border_color_events[event_index].color_idx & 0x07u;
-        segment_start = event_time;
         ++event_index;
     }
-    if (frame_end > segment_start) {
-        border_draw_span(segment_start, frame_end, current_color);
-    }
 
     if (event_index > 0) {
         size_t remaining = border_color_event_count - event_index;
@@ -12256,8 +16480,11 @@ void render_screen(void) {
     border_frame_start_tstate = frame_end;
     border_frame_color = current_color & 0x07u;
 
-    uint64_t frame_count = total_t_states / T_STATES_PER_FRAME;
-    int flash_phase = (int)((frame_count >> 5) & 1ULL);
+    if (skip_pixels) {
+        ++perf_counters.frames_skipped;
+        return;
+    }
+
     const uint8_t* vram_bank = memory + VRAM_START;
     const uint8_t* attr_bank = memory + ATTR_START;
     if (current_screen_bank < 8u) {
@@ -12270,13 +16497,20 @@ void render_screen(void) {
             attr_bank = bank + (ATTR_START - VRAM_START);
         }
     }
-    for (int y = 0; y < SCREEN_HEIGHT; ++y) {
-        for (int x_char = 0; x_char < SCREEN_WIDTH / 8; ++x_char) {
-            uint16_t pix_addr = VRAM_START + ((y & 0xC0) << 5) + ((y & 7) << 8) + ((y & 0x38) << 2) + x_char;
-            uint16_t attr_addr = ATTR_START + (y / 8 * 32) + x_char;
-            uint16_t pix_offset = (uint16_t)(pix_addr - VRAM_START);
-            uint16_t attr_offset = (uint16_t)(attr_addr - ATTR_START);
-            uint8_t pix_byte = vram_bank[pix_offset];
+    int dirty_min_row = SCREEN_CELL_ROWS;
+    int dirty_max_row = -1;
+    int dirty_min_col = SCREEN_CELL_COLS;
+    int dirty_max_col = -1;
+    for (int cell_row = 0; cell_row < SCREEN_CELL_ROWS; ++cell_row) {
+        for (int x_char = 0; x_char < SCREEN_CELL_COLS; ++x_char) {
+            if (!full_redraw && !screen_dirty_cells[cell_row][x_char]) {
+                continue;
+            }
+            if (cell_row < dirty_min_row) dirty_min_row = cell_row;
+            if (cell_row > dirty_max_row) dirty_max_row = cell_row;
+            if (x_char < dirty_min_col) dirty_min_col = x_char;
+            if (x_char > dirty_max_col) dirty_max_col = x_char;
+            uint16_t attr_offset = (uint16_t)(cell_row * 32 + x_char);
             uint8_t attr_byte = attr_bank[attr_offset];
             int ink_idx = attr_byte & 7;
             int pap_idx = (attr_byte >> 3) & 7;
@@ -12290,16 +16524,45 @@ void render_screen(void) {
                 ink = pap;
                 pap = tmp;
             }
-            for (int bit = 0; bit < 8; ++bit) {
-                int sx = BORDER_SIZE + x_char * 8 + (7 - bit);
-                int sy = BORDER_SIZE + y;
-                pixels[sy * TOTAL_WIDTH + sx] = ((pix_byte >> bit) & 1) ? ink : pap;
+            uint32_t ink_xor_pap = ink ^ pap;
+            for (int line = 0; line < 8; ++line) {
+                int y = cell_row * 8 + line;
+                uint16_t pix_offset = (uint16_t)(((y & 0xC0) << 5) + ((y & 7) << 8) + ((y & 0x38) << 2) + x_char);
+                uint8_t pix_byte = vram_bank[pix_offset];
+                const uint32_t* expand = screen_pixel_expand_masks[pix_byte];
+                uint32_t* row = &pixels[(BORDER_SIZE + y) * TOTAL_WIDTH + BORDER_SIZE + x_char * 8];
+                for (int px = 0; px < 8; ++px) {
+                    row[px] = pap ^ (ink_xor_pap & expand[px]);
+                }
             }
         }
     }
+    memset(screen_dirty_cells, 0, sizeof(screen_dirty_cells));
+    screen_force_full_redraw = 0;
+    screen_last_flash_phase = flash_phase;
+    screen_overlay_was_visible = overlay_visible;
+
     tape_render_overlay();
     tape_render_manager();
-    SDL_UpdateTexture(texture, NULL, pixels, TOTAL_WIDTH * sizeof(uint32_t));
+    perf_render_overlay();
+    ++perf_counters.frames_rendered;
+    if (render_thread_active) {
+        // Overlays are already composited into pixels[]; hand the finished
+        // frame to the render thread and return without touching SDL.
+        render_thread_publish_frame();
+        return;
+    }
+    if (border_touched || overlay_visible) {
+        SDL_UpdateTexture(texture, NULL, pixels, TOTAL_WIDTH * sizeof(uint32_t));
+    } else if (dirty_max_row >= 0) {
+        SDL_Rect dirty_rect;
+        dirty_rect.x = BORDER_SIZE + dirty_min_col * 8;
+        dirty_rect.y = BORDER_SIZE + dirty_min_row * 8;
+        dirty_rect.w = (dirty_max_col - dirty_min_col + 1) * 8;
+        dirty_rect.h = (dirty_max_row - dirty_min_row + 1) * 8;
+        const uint32_t* dirty_pixels = &pixels[dirty_rect.y * TOTAL_WIDTH + dirty_rect.x];
+        SDL_UpdateTexture(texture, &dirty_rect, dirty_pixels, TOTAL_WIDTH * sizeof(uint32_t));
+    }
     SDL_RenderClear(renderer);
     SDL_RenderCopy(renderer, texture, NULL, NULL);
     SDL_RenderPresent(renderer);
@@ -12320,6 +16583,10 @@ int map_sdl_key_to_spectrum(SDL_Keycode k, int* r, uint8_t* m) {
 }
 
 // --- Audio Callback ---
+#define AY_RENDER_BLOCK_FRAMES 1024
+static double ay_block_left[AY_RENDER_BLOCK_FRAMES];
+static double ay_block_right[AY_RENDER_BLOCK_FRAMES];
+
 void audio_callback(void* userdata, Uint8* stream, int len) {
     Sint16* buffer = (Sint16*)stream;
     int num_samples = len / (int)sizeof(Sint16);
@@ -12397,9 +16664,21 @@ void audio_callback(void* userdata, Uint8* stream, int len) {
         }
     }
 
+    int ay_block_size = 0;
+    int ay_block_index = 0;
+
     for (int frame = 0; frame < num_frames; ++frame) {
         double target_position = playback_position + cycles_per_sample;
 
+        if (ay_block_index >= ay_block_size) {
+            ay_block_size = num_frames - frame;
+            if (ay_block_size > AY_RENDER_BLOCK_FRAMES) {
+                ay_block_size = AY_RENDER_BLOCK_FRAMES;
+            }
+            ay_render_block(ay_cycles_per_sample, ay_block_size, ay_block_left, ay_block_right);
+            ay_block_index = 0;
+        }
+
         while (beeper_event_head != beeper_event_tail &&
                (double)beeper_events[beeper_event_head].t_state <= target_position) {
             level = beeper_events[beeper_event_head].level;
@@ -12411,9 +16690,9 @@ void audio_callback(void* userdata, Uint8* stream, int len) {
         double filtered_sample = raw_sample - last_input + BEEPER_HP_ALPHA * last_output;
         last_input = raw_sample;
         last_output = filtered_sample;
-        double ay_left = 0.0;
-        double ay_right = 0.0;
-        ay_mix_sample(ay_cycles_per_sample, &ay_left, &ay_right);
+        double ay_left = ay_block_left[ay_block_index];
+        double ay_right = ay_block_right[ay_block_index];
+        ++ay_block_index;
         double left_value = filtered_sample + ay_left;
         double right_value = filtered_sample + ay_right;
         double mono_value = filtered_sample + 0.5 * (ay_left + ay_right);
@@ -12446,6 +16725,9 @@ void audio_callback(void* userdata, Uint8* stream, int len) {
     beeper_playback_level = level;
     beeper_playback_position = playback_position;
     if (beeper_writer_cursor < playback_position) {
+        // The emulation thread has not produced audio up to the point playback
+        // just consumed; the tail of this buffer was stale output.
+        ++perf_counters.audio_underruns;
         beeper_writer_cursor = playback_position;
     }
     beeper_hp_last_input = last_input;
@@ -12494,109 +16776,153 @@ static void border_record_event(uint64_t event_t_state, uint8_t color_idx) {
     ++border_color_event_count;
 }
 
-static void border_draw_span(uint64_t span_start, uint64_t span_end, uint8_t color_idx) {
-    if (span_end <= span_start) {
-        return;
-    }
-
-    uint64_t frame_start = border_frame_start_tstate;
-    if (span_end <= frame_start) {
-        return;
-    }
+// --- Border scanline table ---
+// render_screen() used to flood the whole border with the frame's base colour
+// and then replay border_color_events[] as span fills, so multicolour frames
+// touched most border pixels twice. The events are now folded into one colour
+// per visible scanline and blitted as run-length row fills, with a per-line
+// cache of the colour already sitting in pixels[] so an unchanged border costs
+// nothing. Lines with mid-line colour changes (loader stripes) are painted
+// segment by segment at the same 2-pixels-per-tstate resolution as the old
+// span path and left uncached so they repaint cleanly next frame.
+#define BORDER_LINE_UNPAINTED 0xFFu
+static uint8_t border_scanline_painted[TOTAL_HEIGHT];
 
-    uint64_t frame_end = frame_start + T_STATES_PER_FRAME;
-    if (span_start < frame_start) {
-        span_start = frame_start;
+static void border_fill_line_segment(int y, int col_start, int col_end, uint32_t rgba) {
+    if (col_start < 0) {
+        col_start = 0;
     }
-    if (span_end > frame_end) {
-        span_end = frame_end;
+    if (col_end > TOTAL_WIDTH) {
+        col_end = TOTAL_WIDTH;
     }
-    if (span_end <= span_start) {
+    if (col_start >= col_end) {
         return;
     }
 
-    uint32_t rgba = spectrum_colors[color_idx & 0x07u];
-
-    uint64_t offset_start = span_start - frame_start;
-    uint64_t offset_end = span_end - frame_start;
-
-    uint64_t line_start = offset_start / ULA_T_STATES_PER_LINE;
-    uint64_t line_end = (offset_end + (ULA_T_STATES_PER_LINE - 1u)) / ULA_T_STATES_PER_LINE;
-    if (line_end > ULA_LINES_PER_FRAME) {
-        line_end = ULA_LINES_PER_FRAME;
-    }
-
-    for (uint64_t line = line_start; line < line_end; ++line) {
-        if (line < ULA_VISIBLE_TOP_LINES) {
-            continue;
+    uint32_t* row = &pixels[y * TOTAL_WIDTH];
+    if (y < BORDER_SIZE || y >= BORDER_SIZE + SCREEN_HEIGHT) {
+        for (int x = col_start; x < col_end; ++x) {
+            row[x] = rgba;
         }
-        if (line >= ULA_LINES_PER_FRAME - ULA_VISIBLE_BOTTOM_LINES) {
-            continue;
+    } else {
+        int left_limit = BORDER_SIZE;
+        if (col_start < left_limit) {
+            int left_end = col_end < left_limit ? col_end : left_limit;
+            for (int x = col_start; x < left_end; ++x) {
+                row[x] = rgba;
+            }
         }
 
-        int y = (int)(line - ULA_VISIBLE_TOP_LINES);
-        if (y < 0 || y >= TOTAL_HEIGHT) {
-            continue;
+        int right_limit = TOTAL_WIDTH - BORDER_SIZE;
+        if (col_end > right_limit) {
+            int right_start = col_start > right_limit ? col_start : right_limit;
+            for (int x = right_start; x < col_end; ++x) {
+                row[x] = rgba;
+            }
         }
+    }
+}
 
-        uint64_t line_tstate_start = line * ULA_T_STATES_PER_LINE;
-        uint64_t line_tstate_end = line_tstate_start + ULA_T_STATES_PER_LINE;
+static int border_blit_scanlines(uint8_t start_color, int full_redraw) {
+    uint64_t frame_start = border_frame_start_tstate;
 
-        uint64_t segment_start = offset_start > line_tstate_start ? offset_start : line_tstate_start;
-        uint64_t segment_end = offset_end < line_tstate_end ? offset_end : line_tstate_end;
-        if (segment_end <= segment_start) {
-            continue;
+    if (full_redraw) {
+        // Cell redraws and overlays may have scribbled over cached border
+        // pixels, so forget what the buffer holds and repaint every line.
+        memset(border_scanline_painted, BORDER_LINE_UNPAINTED, sizeof(border_scanline_painted));
+    }
+
+    uint8_t line_colors[TOTAL_HEIGHT];
+    uint8_t line_done[TOTAL_HEIGHT];
+    memset(line_done, 0, sizeof(line_done));
+
+    // Pass 1: fold the event list into one colour per visible scanline.
+    // Lines hit by a mid-line event are painted immediately at column
+    // resolution and excluded from the cached blit below.
+    uint8_t color = start_color & 0x07u;
+    size_t ev = 0;
+    for (uint64_t line = 0; line < ULA_LINES_PER_FRAME; ++line) {
+        uint64_t line_t_start = frame_start + line * ULA_T_STATES_PER_LINE;
+        uint64_t line_t_end = line_t_start + ULA_T_STATES_PER_LINE;
+        int y = -1;
+        if (line >= ULA_VISIBLE_TOP_LINES && line < ULA_LINES_PER_FRAME - ULA_VISIBLE_BOTTOM_LINES) {
+            int candidate = (int)(line - ULA_VISIBLE_TOP_LINES);
+            if (candidate < TOTAL_HEIGHT) {
+                y = candidate;
+            }
         }
 
-        uint64_t rel_start = segment_start - line_tstate_start;
-        uint64_t rel_end = segment_end - line_tstate_start;
-
-        if (rel_start >= ULA_LINE_VISIBLE_TSTATES) {
+        if (ev >= border_color_event_count ||
+            border_color_events[ev].t_state >= line_t_end ||
+            border_color_events[ev].t_state < line_t_start) {
+            if (y >= 0) {
+                line_colors[y] = color;
+            }
             continue;
         }
-        if (rel_end > ULA_LINE_VISIBLE_TSTATES) {
-            rel_end = ULA_LINE_VISIBLE_TSTATES;
-        }
 
-        int col_start = (int)(rel_start * 2u);
-        int col_end = (int)(rel_end * 2u);
-
-        if (col_start < 0) {
-            col_start = 0;
+        uint64_t segment_t = line_t_start;
+        while (ev < border_color_event_count && border_color_events[ev].t_state < line_t_end) {
+            uint64_t event_t = border_color_events[ev].t_state;
+            if (y >= 0 && event_t > segment_t) {
+                border_fill_line_segment(y,
+                                         (int)((segment_t - line_t_start) * 2u),
+                                         (int)((event_t - line_t_start) * 2u),
+                                         spectrum_colors[color]);
+            }
+            color = border_color_events[ev].color_idx & 0x07u;
+            segment_t = event_t;
+            ++ev;
+        }
+        if (y >= 0) {
+            if (line_t_end > segment_t) {
+                border_fill_line_segment(y,
+                                         (int)((segment_t - line_t_start) * 2u),
+                                         TOTAL_WIDTH,
+                                         spectrum_colors[color]);
+            }
+            line_done[y] = 1u;
+            border_scanline_painted[y] = BORDER_LINE_UNPAINTED;
         }
-        if (col_end > TOTAL_WIDTH) {
-            col_end = TOTAL_WIDTH;
+    }
+
+    // Pass 2: blit single-colour lines, skipping lines whose colour already
+    // matches the buffer and merging adjacent full-width rows of the top and
+    // bottom bands into one contiguous run fill.
+    int touched = 0;
+    for (int y = 0; y < TOTAL_HEIGHT; ++y) {
+        if (line_done[y]) {
+            touched = 1;
+            continue;
         }
-        if (col_start >= col_end) {
+        uint8_t line_color = line_colors[y];
+        if (border_scanline_painted[y] == line_color) {
             continue;
         }
 
-        uint32_t* row = &pixels[y * TOTAL_WIDTH];
         if (y < BORDER_SIZE || y >= BORDER_SIZE + SCREEN_HEIGHT) {
-            for (int x = col_start; x < col_end; ++x) {
-                row[x] = rgba;
-            }
-        } else {
-            int left_limit = BORDER_SIZE;
-            if (col_start < left_limit) {
-                int left_start = col_start;
-                int left_end = col_end < left_limit ? col_end : left_limit;
-                for (int x = left_start; x < left_end; ++x) {
-                    row[x] = rgba;
-                }
+            int band_end = y < BORDER_SIZE ? BORDER_SIZE : TOTAL_HEIGHT;
+            int run_end = y;
+            while (run_end < band_end && !line_done[run_end] &&
+                   line_colors[run_end] == line_color &&
+                   border_scanline_painted[run_end] != line_color) {
+                border_scanline_painted[run_end] = line_color;
+                ++run_end;
             }
-
-            int right_limit = TOTAL_WIDTH - BORDER_SIZE;
-            if (col_end > right_limit) {
-                int right_start = col_start > right_limit ? col_start : right_limit;
-                if (right_start < col_end) {
-                    for (int x = right_start; x < col_end; ++x) {
-                        row[x] = rgba;
-                    }
-                }
+            uint32_t rgba = spectrum_colors[line_color];
+            uint32_t* run = &pixels[y * TOTAL_WIDTH];
+            size_t run_pixels = (size_t)(run_end - y) * (size_t)TOTAL_WIDTH;
+            for (size_t i = 0; i < run_pixels; ++i) {
+                run[i] = rgba;
             }
+            y = run_end - 1;
+        } else {
+            border_fill_line_segment(y, 0, TOTAL_WIDTH, spectrum_colors[line_color]);
+            border_scanline_painted[y] = line_color;
         }
+        touched = 1;
     }
+    return touched;
 }
 
 // --- Main Program ---
@@ -12604,8 +16930,11 @@ int main(int argc, char *argv[]) {
     const char* rom_filename = NULL;
     int rom_provided = 0;
     int run_tests = 0;
+    int run_bench = 0;
     const char* test_rom_dir = "tests/roms";
     const char* snapshot_test_dir = "tests/snapshots";
+    const char* input_record_path = NULL;
+    const char* input_replay_path = NULL;
     int launch_fullscreen = 0;
     Z80 cpu;
     memset(&cpu, 0, sizeof(cpu));
@@ -12613,6 +16942,9 @@ int main(int argc, char *argv[]) {
 
     spectrum_init_log_output();
     spectrum_init_user_paths();
+    spectrum_rebuild_contention_table();
+    cpu_init_flag_tables();
+    screen_init_pixel_expand_masks();
 
     tape_set_input_path(NULL);
     snapshot_set_input_path(NULL);
@@ -12630,17 +16962,7 @@ int main(int argc, char *argv[]) {
                 return 1;
             }
             const char* model_value = argv[++i];
-            if (string_equals_case_insensitive(model_value, "48k")) {
-                spectrum_configure_model(SPECTRUM_MODEL_48K);
-            } else if (string_equals_case_insensitive(model_value, "128k")) {
-                spectrum_configure_model(SPECTRUM_MODEL_128K);
-            } else if (string_equals_case_insensitive(model_value, "plus2a") ||
-                       string_equals_case_insensitive(model_value, "+2a")) {
-                spectrum_configure_model(SPECTRUM_MODEL_PLUS2A);
-            } else if (string_equals_case_insensitive(model_value, "plus3") ||
-                       string_equals_case_insensitive(model_value, "+3")) {
-                spectrum_configure_model(SPECTRUM_MODEL_PLUS3);
-            } else {
+            if (!spectrum_configure_model_by_name(model_value)) {
                 fprintf(stderr, "Unknown model: %s\n", model_value);
                 return 1;
             }
@@ -12713,6 +17035,8 @@ int main(int argc, char *argv[]) {
         } else if (strcmp(argv[i], "--tape-debug") == 0) {
             tape_debug_logging = 1;
             tape_log("Tape debug logging enabled\n");
+        } else if (strcmp(argv[i], "--tape-preload") == 0) {
+            tape_preload_waveform = 1;
         } else if (strcmp(argv[i], "--paging-log") == 0) {
             paging_debug_logging = 1;
             spectrum_log_paging_state("paging debug enabled", 0u, 0u, total_t_states);
@@ -12785,6 +17109,26 @@ int main(int argc, char *argv[]) {
                 fprintf(stderr, "Unsupported snapshot type for '%s'\n", snapshot_input_path);
                 return 1;
             }
+        } else if (strcmp(argv[i], "--rewind") == 0) {
+            rewind_enabled = 1;
+        } else if (strcmp(argv[i], "--save-snapshot") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            strncpy(snapshot_save_path_storage, argv[++i], sizeof(snapshot_save_path_storage) - 1u);
+            snapshot_save_path_storage[sizeof(snapshot_save_path_storage) - 1u] = '\0';
+            snapshot_save_path = snapshot_save_path_storage;
+        } else if (strcmp(argv[i], "--save-snapshot-at-frame") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            snapshot_save_at_frame = strtoull(argv[++i], NULL, 10);
+            if (snapshot_save_at_frame == 0) {
+                fprintf(stderr, "--save-snapshot-at-frame requires a positive frame count\n");
+                return 1;
+            }
         } else if (strcmp(argv[i], "--save-tap") == 0) {
             if (i + 1 >= argc) {
                 print_usage(argv[0]);
@@ -12819,6 +17163,84 @@ int main(int argc, char *argv[]) {
             snapshot_test_dir = argv[++i];
         } else if (strcmp(argv[i], "--run-tests") == 0) {
             run_tests = 1;
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            run_bench = 1;
+        } else if (strcmp(argv[i], "--batch") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            batch_jobs_path = argv[++i];
+        } else if (strcmp(argv[i], "--parallel") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            batch_parallel = atoi(argv[++i]);
+            if (batch_parallel < 1) {
+                fprintf(stderr, "--parallel requires a positive job count\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            headless_mode = 1;
+        } else if (strcmp(argv[i], "--turbo") == 0) {
+            turbo_mode = 1;
+        } else if (strcmp(argv[i], "--fast-boot") == 0) {
+            fast_boot_enabled = 1;
+        } else if (strcmp(argv[i], "--record-input") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            input_record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay-input") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            input_replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--core") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            ++i;
+            if (strcmp(argv[i], "fast") == 0) {
+                active_cpu_step = cpu_step_fast;
+            } else if (strcmp(argv[i], "reference") == 0) {
+                active_cpu_step = cpu_step;
+            } else {
+                fprintf(stderr, "--core requires 'fast' or 'reference'\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--exit-after-frames") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            exit_after_frames = strtoull(argv[++i], NULL, 10);
+            if (exit_after_frames == 0) {
+                fprintf(stderr, "--exit-after-frames requires a positive frame count\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--exit-after-tstates") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            exit_after_tstates = strtoull(argv[++i], NULL, 10);
+            if (exit_after_tstates == 0) {
+                fprintf(stderr, "--exit-after-tstates requires a positive t-state count\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--frame-skip") == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            frame_skip_interval = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--render-thread") == 0) {
+            render_thread_requested = 1;
         } else if (strcmp(argv[i], "--fullscreen") == 0) {
             launch_fullscreen = 1;
         } else {
@@ -12845,6 +17267,99 @@ int main(int argc, char *argv[]) {
         return run_cpu_tests(test_rom_dir, snapshot_test_dir);
     }
 
+    if (run_bench) {
+        return run_benchmarks();
+    }
+
+    if (batch_jobs_path) {
+#ifdef _WIN32
+        fprintf(stderr, "--batch requires fork() and is not available on this platform\n");
+        return 1;
+#else
+        headless_mode = 1;
+        char** job_lines = NULL;
+        size_t job_count = 0;
+        if (!batch_read_jobs(batch_jobs_path, &job_lines, &job_count)) {
+            return 1;
+        }
+        if (job_count == 0) {
+            fprintf(stderr, "Batch job file '%s' contains no jobs\n", batch_jobs_path);
+            return 1;
+        }
+
+        long batch_child_job = -1;
+        pid_t* job_pids = calloc(job_count, sizeof(pid_t));
+        if (!job_pids) {
+            return 1;
+        }
+        size_t next_job = 0;
+        size_t active_jobs = 0;
+        size_t failed_jobs = 0;
+        printf("Batch: %zu jobs, %d parallel\n", job_count, batch_parallel);
+        while (next_job < job_count || active_jobs > 0) {
+            while (active_jobs < (size_t)batch_parallel && next_job < job_count) {
+                pid_t pid = fork();
+                if (pid < 0) {
+                    fprintf(stderr, "fork failed for job %zu: %s\n", next_job, strerror(errno));
+                    ++failed_jobs;
+                    ++next_job;
+                    continue;
+                }
+                if (pid == 0) {
+                    batch_child_job = (long)next_job;
+                    break;
+                }
+                job_pids[next_job] = pid;
+                ++next_job;
+                ++active_jobs;
+            }
+            if (batch_child_job >= 0) {
+                break;
+            }
+            if (active_jobs == 0) {
+                break;
+            }
+            int status = 0;
+            pid_t finished = wait(&status);
+            if (finished < 0) {
+                break;
+            }
+            int ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            for (size_t j = 0; j < next_job; ++j) {
+                if (job_pids[j] == finished) {
+                    printf("Job %zu %s: %s\n", j, ok ? "PASS" : "FAIL", job_lines[j]);
+                    break;
+                }
+            }
+            if (!ok) {
+                ++failed_jobs;
+            }
+            --active_jobs;
+        }
+
+        if (batch_child_job < 0) {
+            printf("Batch complete: %zu jobs, %zu failed\n", job_count, failed_jobs);
+            return failed_jobs > 0u ? 1 : 0;
+        }
+
+        // Child: its own log, its own inputs, then on through the normal
+        // startup path with the machine state fork copied from the parent.
+        free(job_pids);
+        char job_log_name[64];
+        snprintf(job_log_name, sizeof(job_log_name), "batch-job-%02ld.log", batch_child_job);
+        if (freopen(job_log_name, "w", stdout)) {
+            setvbuf(stdout, NULL, _IOLBF, 0);
+        }
+        if (freopen(job_log_name, "a", stderr)) {
+            setvbuf(stderr, NULL, _IONBF, 0);
+        }
+        printf("Batch job %ld: %s\n", batch_child_job, job_lines[batch_child_job]);
+        if (!batch_apply_job_line(job_lines[batch_child_job])) {
+            return 1;
+        }
+#endif
+    }
+
     if (snapshot_input_path) {
         const char* resolved_snapshot = spectrum_resolve_input_path(snapshot_input_path,
                                                                      spectrum_user_snapshots_dir,
@@ -12964,13 +17479,17 @@ int main(int argc, char *argv[]) {
                 tape_free_image(&tape_playback.image);
                 return 1;
             }
-            if (!tape_generate_waveform_from_image(&tape_playback.image, &tape_playback.waveform)) {
+            int waveform_ready = tape_preload_waveform
+                                     ? tape_generate_waveform_from_image(&tape_playback.image, &tape_playback.waveform)
+                                     : tape_waveform_stream_init(&tape_playback.image, &tape_playback.waveform);
+            if (!waveform_ready) {
                 fprintf(stderr, "Failed to synthesise tape playback waveform for '%s'\n", tape_input_path);
                 tape_free_image(&tape_playback.image);
                 tape_waveform_reset(&tape_playback.waveform);
                 return 1;
             }
             tape_playback.use_waveform_playback = 1;
+            (void)tape_build_block_index(&tape_playback);
             printf("Loaded tape image %s (%zu blocks)\n", tape_input_path, tape_playback.image.count);
             if (tape_playback.image.count == 0) {
                 fprintf(stderr, "Warning: tape image '%s' is empty\n", tape_input_path);
@@ -12999,10 +17518,16 @@ int main(int argc, char *argv[]) {
 
     speaker_output_level = speaker_calculate_output_level();
 
-    if(!init_sdl()){tape_shutdown();cleanup_sdl();return 1;}
+    if (headless_mode) {
+        printf("Headless mode: skipping SDL initialisation.\n");
+    } else {
+        if(!init_sdl()){tape_shutdown();cleanup_sdl();return 1;}
+
+        if (launch_fullscreen && !window_fullscreen) {
+            toggle_fullscreen();
+        }
 
-    if (launch_fullscreen && !window_fullscreen) {
-        toggle_fullscreen();
+        render_thread_start();
     }
 
     if (snapshot_input_format == SNAPSHOT_FORMAT_NONE) {
@@ -13027,6 +17552,14 @@ int main(int argc, char *argv[]) {
         printf("Quickloaded tape and jumping to 0x%04X\n", tape_quickload_entry);
     }
 
+    if (fast_boot_enabled) {
+        if (snapshot_input_format != SNAPSHOT_FORMAT_NONE || tape_quickload_ready) {
+            printf("Fast boot: skipped (a snapshot or quickload already primes the machine).\n");
+        } else {
+            fast_boot_prepare(&cpu);
+        }
+    }
+
     if (tape_input_enabled) {
         tape_reset_playback(&tape_playback);
         tape_deck_status = TAPE_DECK_STATUS_STOP;
@@ -13059,6 +17592,13 @@ int main(int argc, char *argv[]) {
         printf("Auto-load: typing LOAD \"\" and starting tape playback.\n");
     }
 
+    if (input_replay_path && !input_replay_load(input_replay_path)) {
+        return 1;
+    }
+    if (input_record_path && !input_record_begin(input_record_path)) {
+        return 1;
+    }
+
     printf("Starting Z80 emulation...\n");
 
     int quit = 0;
@@ -13069,7 +17609,7 @@ int main(int argc, char *argv[]) {
     int frame_t_state_accumulator = 0;
 
     while (!quit) {
-        while (SDL_PollEvent(&e) != 0) {
+        while (!headless_mode && SDL_PollEvent(&e) != 0) {
             if (e.type == SDL_QUIT) {
                 quit = 1;
             } else if (e.type == SDL_MOUSEBUTTONDOWN) {
@@ -13092,6 +17632,23 @@ int main(int argc, char *argv[]) {
                         toggle_fullscreen();
                         continue;
                     }
+                    if (sym == SDLK_F9) {
+                        turbo_mode = !turbo_mode;
+                        printf("Turbo mode %s\n", turbo_mode ? "enabled" : "disabled");
+                        continue;
+                    }
+                    if (sym == SDLK_F10) {
+                        snapshot_save_request(&cpu);
+                        continue;
+                    }
+                    if (sym == SDLK_F12 && rewind_enabled) {
+                        rewind_step_back(&cpu);
+                        continue;
+                    }
+                    if (sym == SDLK_F4) {
+                        perf_overlay_visible = !perf_overlay_visible;
+                        continue;
+                    }
                 }
                 if (tape_handle_control_key(&e)) {
                     continue;
@@ -13102,7 +17659,7 @@ int main(int argc, char *argv[]) {
                 int row = -1;
                 uint8_t mask = 0;
                 int mapped = map_sdl_key_to_spectrum(e.key.keysym.sym, &row, &mask);
-                if (mapped) {
+                if (mapped && !input_replay_mode) {
                     if (e.type == SDL_KEYDOWN) {
                         keyboard_matrix[row] &= ~mask;
                         if (e.key.keysym.sym == SDLK_BACKSPACE) {
@@ -13114,6 +17671,10 @@ int main(int argc, char *argv[]) {
                             keyboard_matrix[0] |= 0x01; // Release Shift
                         }
                     }
+                    input_record_key(total_t_states, row, keyboard_matrix[row]);
+                    if (e.key.keysym.sym == SDLK_BACKSPACE) {
+                        input_record_key(total_t_states, 0, keyboard_matrix[0]);
+                    }
                 }
             }
         }
@@ -13122,24 +17683,36 @@ int main(int argc, char *argv[]) {
             break;
         }
 
-        uint64_t current_counter = SDL_GetPerformanceCounter();
-        double elapsed_seconds = (double)(current_counter - previous_counter) / (double)performance_frequency;
-        previous_counter = current_counter;
+        if (headless_mode || turbo_mode || input_replay_mode) {
+            // No wall-clock coupling wanted: execute exactly one frame's
+            // worth of cycles per loop iteration. Replay mode relies on this
+            // so the t-state sequence is identical on every host; without
+            // --turbo it still paces itself to roughly real time below.
+            cycle_accumulator = (double)T_STATES_PER_FRAME;
+            previous_counter = SDL_GetPerformanceCounter();
+            if (input_replay_mode && !headless_mode && !turbo_mode) {
+                SDL_Delay(20);
+            }
+        } else {
+            uint64_t current_counter = SDL_GetPerformanceCounter();
+            double elapsed_seconds = (double)(current_counter - previous_counter) / (double)performance_frequency;
+            previous_counter = current_counter;
 
-        if (elapsed_seconds < 0.0) {
-            elapsed_seconds = 0.0;
-        }
+            if (elapsed_seconds < 0.0) {
+                elapsed_seconds = 0.0;
+            }
 
-        if (tape_autoload_fast_forward_active()) {
-            elapsed_seconds = 0.25;
-        }
+            if (tape_autoload_fast_forward_active()) {
+                elapsed_seconds = 0.25;
+            }
 
-        cycle_accumulator += elapsed_seconds * CPU_CLOCK_HZ;
-        if (cycle_accumulator > CPU_CLOCK_HZ * 0.25) {
-            cycle_accumulator = CPU_CLOCK_HZ * 0.25;
+            cycle_accumulator += elapsed_seconds * CPU_CLOCK_HZ;
+            if (cycle_accumulator > CPU_CLOCK_HZ * 0.25) {
+                cycle_accumulator = CPU_CLOCK_HZ * 0.25;
+            }
         }
 
-        if (!tape_autoload_fast_forward_active() && audio_available && beeper_cycles_per_sample > 0.0) {
+        if (!headless_mode && !turbo_mode && !input_replay_mode && !tape_autoload_fast_forward_active() && audio_available && beeper_cycles_per_sample > 0.0) {
             double latency_samples = beeper_current_latency_samples();
             double threshold = beeper_latency_threshold();
             if (latency_samples >= threshold) {
@@ -13150,7 +17723,9 @@ int main(int argc, char *argv[]) {
         }
 
         if (cycle_accumulator < 1.0) {
-            SDL_Delay(0);
+            if (!headless_mode) {
+                SDL_Delay(0);
+            }
             continue;
         }
 
@@ -13160,23 +17735,27 @@ int main(int argc, char *argv[]) {
         int throttled_audio = 0;
         double throttled_latency_samples = 0.0;
 
-        if (audio_available && beeper_cycles_per_sample > 0.0) {
+        if (audio_available && !turbo_mode && !input_replay_mode && beeper_cycles_per_sample > 0.0) {
             latency_poll_threshold = (int)(beeper_cycles_per_sample * 32.0);
             if (latency_poll_threshold < 128) {
                 latency_poll_threshold = 128;
             }
         }
 
+        // Event handling above may have started or stopped any subsystem.
+        scheduler_invalidate();
+
         while (cycles_to_execute > 0) {
             if (cpu.ei_delay) {
                 cpu.iff1 = cpu.iff2 = 1;
                 cpu.ei_delay = 0;
             }
 
-            int t_states = cpu.halted ? 4 : cpu_step(&cpu);
+            int t_states = cpu.halted ? 4 : active_cpu_step(&cpu);
             if (t_states <= 0) {
                 t_states = 4;
             }
+            ++perf_counters.instructions_retired;
 
             cycles_to_execute -= t_states;
             cycle_accumulator -= t_states;
@@ -13187,10 +17766,14 @@ int main(int argc, char *argv[]) {
             frame_t_state_accumulator += t_states;
             total_t_states += t_states;
 
-            ula_process_port_events(total_t_states);
-            tape_update(total_t_states);
-            tape_recorder_update(total_t_states, 0);
-            tape_autoload_update(total_t_states);
+            if (exit_after_tstates > 0 && total_t_states >= exit_after_tstates) {
+                printf("Reached %" PRIu64 " T-states; exiting.\n", total_t_states);
+                quit = 1;
+            }
+
+            if (total_t_states >= scheduler_next_deadline) {
+                scheduler_service(total_t_states);
+            }
 
             if (audio_available && latency_poll_threshold > 0) {
                 latency_poll_cycles += t_states;
@@ -13211,8 +17794,27 @@ int main(int argc, char *argv[]) {
                     total_t_states += interrupt_t_states;
                     frame_t_state_accumulator += interrupt_t_states;
                 }
+                render_skip_current_frame = frame_render_should_skip();
                 render_screen();
+                render_skip_current_frame = 0;
                 frame_t_state_accumulator -= T_STATES_PER_FRAME;
+                emulated_frame_count++;
+                perf_frame_tick();
+                if (rewind_enabled && emulated_frame_count % REWIND_CAPTURE_INTERVAL_FRAMES == 0u) {
+                    (void)rewind_capture(&cpu);
+                }
+                if (snapshot_save_at_frame > 0 && emulated_frame_count == snapshot_save_at_frame) {
+                    snapshot_save_request(&cpu);
+                }
+                if (exit_after_frames > 0 && emulated_frame_count >= exit_after_frames) {
+                    printf("Reached %" PRIu64 " frames; exiting.\n", emulated_frame_count);
+                    quit = 1;
+                    break;
+                }
+            }
+
+            if (quit) {
+                break;
             }
         }
 
@@ -13223,7 +17825,10 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    render_thread_stop();
     spectrum_log_ram_hashes("exit");
+    input_record_finish();
+    input_replay_shutdown();
     printf("Emulation finished.\nFinal State:\nPC:%04X SP:%04X AF:%04X BC:%04X DE:%04X HL:%04X IX:%04X IY:%04X\n",cpu.reg_PC,cpu.reg_SP,get_AF(&cpu),get_BC(&cpu),get_DE(&cpu),get_HL(&cpu),cpu.reg_IX,cpu.reg_IY);
     tape_shutdown();
     cleanup_sdl(); return 0;
@@ -13250,6 +17855,8 @@ static void ula_queue_port_value(uint8_t value) {
         ula_write_queue[ula_write_count - 1].value = value;
         ula_write_queue[ula_write_count - 1].t_state = event_t_state;
     }
+
+    scheduler_invalidate();
 }
 
 static void ula_process_port_events(uint64_t current_t_state) {